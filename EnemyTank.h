@@ -2,12 +2,20 @@
 #define ENEMYTANK_H
 
 // Include necessary libraries and headers
-#include "raylib.h"  // Raylib library for graphics and input handling
+#include "simTypes.h"  // Value types, from raylib unless built headless
 #include "TankShell.h"  // Header for TankShell class
-#include <random>  // Standard library for random number generation
+#include "simRandom.h"  // Header for the seeded random streams
 #include <array>  // Standard library for array container
 #include <string>  // Standard library for string handling
+#include <algorithm>  // Standard library for max
+#include <cmath>  // Standard library for lroundf
 #include "PlayerTank.h"  // Header for PlayerTank class
+#include "entityGrid.h"  // Header for the bucket grid used to find nearby tanks
+#include "aabbBatch.h"  // Header for batched rectangle overlap tests
+#include "collision.h"  // Header for collision layers and contacts
+#ifndef SIM_HEADLESS
+#include "renderQueue.h"  // Header for the layered draw queue
+#endif
 
 using namespace std;  // Use the standard namespace
 
@@ -29,38 +37,140 @@ enum EnemyType {
 };
 
 // Define the EnemyTank class
+// A tank waiting to spawn, it becomes a row of EnemyTanks when there is room for it
 class EnemyTank {
 public:
     Rectangle posAndRect;  // Position and rectangle of the enemy tank
     EnemyType Type;        // Type of the enemy tank (BASIC or ADVANCED)
-    Rectangle Rect;        // Rectangle representing the size of the tank
-    bool hasSpawned = false;  // Whether the tank has spawned
-    Vector2 Position;      // Position of the tank
-    float Speed = 100.0f;  // Speed of the tank
+    float timeLimit;       // Time limit for the first direction change
 
-    Direction guidedDirection = DOWN;  // Direction guided by player position
-    Direction currentDirection = DOWN; // Current movement direction
+    // Constructor for the EnemyTank class
+    EnemyTank(EnemyType enemyType, Vector2 WH, Vector2 Pos, int timeUntilNextDirectionChange) {
+        Type = enemyType;  // Set the type of the tank
+        timeLimit = timeUntilNextDirectionChange;  // Set the time limit for direction change
+        posAndRect = { Pos.x, Pos.y, WH.x, WH.y };  // Set the position and rectangle
+    }
+};
 
-    Direction Rotation;    // Rotation of the tank
+// Define the EnemyTanks class
+// The live enemy tanks, one array per field so each update pass only streams the fields it reads. The hot arrays are used
+// every tick, the cold ones only on a shot, a direction change or for the debug text. A tank is a row index; removing one
+// moves the last row into its place, so rows are not stable across removeDestroyed().
+class EnemyTanks {
+public:
+    // Hot, read or written every tick
+    vector<Rectangle> posAndRects;       // Position and rectangle of each tank
+    vector<Vector2> previousPositions;   // Top left corner at the previous tick, drawing blends from it to posAndRects
+    vector<Direction> currentDirections; // Current movement direction
+    vector<float> speeds;                // Speed of each tank
+    vector<float> elapsedTimes;          // Elapsed time since the last direction change
+    vector<int> shotCountdowns;          // Ticks until the next shot, -1 until the tank's first tick
+    vector<unsigned char> destroyed;     // Set when a shell hits the tank, the row is removed at the end of the collision pass
+    RectBatch bounds;                    // Edges of posAndRects for the batched overlap test, change a rectangle with setRect()
+
+    // Cold, read when something happens
+    vector<float> timeLimits;            // Time until the next direction change
+    vector<float> shootingIntervals;     // Interval between shots in seconds
+    vector<Direction> guidedDirections;  // Direction towards the player, picked from on a direction change
+    vector<EnemyType> types;             // Type of each tank
+
+    // Shared by the whole group
+    float accumulatedTime = 0.0f;        // Time not yet added to the elapsed times (they are brought up to date every 0.1s)
+    vector<int> nearbyTanks;             // Tank indices returned by the bucket grid, scratch for every query on these tanks
+
+    // Get the number of tanks
+    size_t size() const {
+        return posAndRects.size();
+    }
 
-    Vector2 centre;        // Center position of the tank
+    // Whether there are no tanks
+    bool empty() const {
+        return posAndRects.empty();
+    }
 
-    float timeLimit;       // Time limit for direction change
-    float elapsedTime;     // Elapsed time since last direction change
+    // Get the centre of a tank
+    Vector2 centre(size_t i) const {
+        return { posAndRects[i].x + posAndRects[i].width / 2, posAndRects[i].y + posAndRects[i].height / 2 };
+    }
 
-    float shootingInterval = 1.30f;  // Interval between shots
+    // Move a tank, keeping its edges in step
+    void setRect(size_t i, const Rectangle& rect) {
+        posAndRects[i] = rect;
+        bounds.set((int)i, rect);
+    }
 
-    float bufferDistance = 10.0f;    // Buffer distance for collision handling
+    // Add a tank at the end, returns its row
+    int add(const EnemyTank& enemyTank) {
+        posAndRects.push_back(enemyTank.posAndRect);
+        bounds.push(enemyTank.posAndRect);
+        previousPositions.push_back({ enemyTank.posAndRect.x, enemyTank.posAndRect.y });  // Nothing to blend from yet
+        currentDirections.push_back(DOWN);
+        speeds.push_back(100.0f);
+        elapsedTimes.push_back(0.0f);
+        shotCountdowns.push_back(-1);
+        destroyed.push_back(0);
+        timeLimits.push_back(enemyTank.timeLimit);
+        shootingIntervals.push_back(1.30f);
+        guidedDirections.push_back(DOWN);
+        types.push_back(enemyTank.Type);
+        return (int)size() - 1;
+    }
 
-    // Constructor for the EnemyTank class
-    EnemyTank(EnemyType enemyType, Vector2 WH, Vector2 Pos, int timeUntilNextDirectionChange) {
-        Type = enemyType;  // Set the type of the tank
-        Rect = { WH.x , WH.y };  // Set the size of the tank
-        Position = { Pos.x , Pos.y };  // Set the position of the tank
+    // Remove a tank by moving the last one into its row
+    void removeAt(size_t i) {
+        size_t last = size() - 1;
+        if (i != last) {
+            posAndRects[i] = posAndRects[last];
+            previousPositions[i] = previousPositions[last];
+            currentDirections[i] = currentDirections[last];
+            speeds[i] = speeds[last];
+            elapsedTimes[i] = elapsedTimes[last];
+            shotCountdowns[i] = shotCountdowns[last];
+            destroyed[i] = destroyed[last];
+            timeLimits[i] = timeLimits[last];
+            shootingIntervals[i] = shootingIntervals[last];
+            guidedDirections[i] = guidedDirections[last];
+            types[i] = types[last];
+        }
+        bounds.removeAt((int)i);
+        posAndRects.pop_back();
+        previousPositions.pop_back();
+        currentDirections.pop_back();
+        speeds.pop_back();
+        elapsedTimes.pop_back();
+        shotCountdowns.pop_back();
+        destroyed.pop_back();
+        timeLimits.pop_back();
+        shootingIntervals.pop_back();
+        guidedDirections.pop_back();
+        types.pop_back();
+    }
 
-        centre = { Pos.x + WH.x / 2, Pos.y + WH.y / 2 };  // Calculate the center position
-        timeLimit = timeUntilNextDirectionChange;  // Set the time limit for direction change
-        posAndRect = { Pos.x, Pos.y, WH.x, WH.y };  // Set the position and rectangle
+    // Remove every destroyed tank, returns whether any was removed
+    bool removeDestroyed() {
+        bool removed = false;
+        for (size_t i = size(); i-- > 0; ) {  // Back to front, the row moved in has already been checked
+            if (!destroyed[i]) continue;
+            removeAt(i);
+            removed = true;
+        }
+        return removed;
+    }
+
+    // Remove every tank
+    void clear() {
+        posAndRects.clear();
+        bounds.clear();
+        previousPositions.clear();
+        currentDirections.clear();
+        speeds.clear();
+        elapsedTimes.clear();
+        shotCountdowns.clear();
+        destroyed.clear();
+        timeLimits.clear();
+        shootingIntervals.clear();
+        guidedDirections.clear();
+        types.clear();
     }
 };
 
@@ -69,186 +179,244 @@ bool areRectanglesDifferent(const Rectangle& rect1, const Rectangle& rect2) {
     return rect1.x != rect2.x || rect1.y != rect2.y || rect1.width != rect2.width || rect1.height != rect2.height;
 }
 
-// Function to update enemy tanks
-void updateEnemyTanks(vector<EnemyTank>& allEnemyTanks, Rectangle& playerTankRect, float& playerTankPositionY, vector<Obstacle>& obstacles, int& CanvasWidth, int& canvasHeight, float& deltaTime, vector<TankShell>& playerTankShells, Camera2D& camera) {
+// Number of enemy tanks from which the bucket grid is used, below it one batched pass over every tank is quicker
+const int enemyGridThreshold = 128;
+
+// Function to fill the bucket grid with the current enemy tank rectangles (left empty below enemyGridThreshold)
+void rebuildEnemyGrid(EntityGrid& enemyGrid, const EnemyTanks& allEnemyTanks) {
+    enemyGrid.clear();  // Remove last frame's entries
+    if ((int)allEnemyTanks.size() < enemyGridThreshold) return;  // The queries scan every tank instead
+    for (size_t i = 0; i < allEnemyTanks.size(); i++) {
+        enemyGrid.insert((int)i, allEnemyTanks.posAndRects[i]);  // Store each tank by row
+    }
+}
+
+// Function to find the first enemy tank overlapping a rectangle, returns its row or -1
+// Tanks, shells and spawns all use it. searchArea is where the grid is searched. ignoreRect leaves a moving tank itself out (nullptr if none).
+int findOverlappingEnemy(const Rectangle& rect, const Rectangle& searchArea, const EnemyTanks& allEnemyTanks, const Rectangle* ignoreRect,
+    EntityGrid& enemyGrid, vector<int>& nearbyTanks) {
+    if (enemyGrid.size() != (int)allEnemyTanks.size()) {  // The grid does not hold every tank, test them all 8 at a time
+        for (int first = 0; first < allEnemyTanks.bounds.size(); first += 8) {
+            unsigned mask = overlapMask(rect, allEnemyTanks.bounds, first);
+            while (mask) {
+                int index = first + lowestLane(mask);  // Earliest tank in row order
+                mask &= mask - 1;
+                if (allEnemyTanks.destroyed[index]) continue;  // Already hit this frame
+                if (ignoreRect && !areRectanglesDifferent(*ignoreRect, allEnemyTanks.posAndRects[index])) continue;  // The moving tank itself
+                return index;
+            }
+        }
+        return -1;
+    }
+
+    enemyGrid.query(searchArea, nearbyTanks);  // Only look at the enemy tanks near the rectangle
+
+    int hit = -1;  // Earliest tank in row order, whatever order the buckets return them in
+    for (int index : nearbyTanks) {
+        if (hit >= 0 && index > hit) continue;  // An earlier tank already overlaps
+        if (allEnemyTanks.destroyed[index]) continue;  // Already hit this frame
+        const Rectangle& posAndRect = allEnemyTanks.posAndRects[index];
+        if (ignoreRect && !areRectanglesDifferent(*ignoreRect, posAndRect)) continue;  // The moving tank itself
+        if (CheckCollisionRecs(rect, posAndRect)) hit = index;
+    }
+    return hit;
+}
+
+// Function to update enemy tanks, called once per fixed tick (deltaTime is the tick length)
+void updateEnemyTanks(EnemyTanks& allEnemyTanks, EntityGrid& enemyGrid, Rectangle& playerTankRect, float& playerTankPositionY, TileMap& tileMap, int& CanvasWidth, int& canvasHeight, float& deltaTime, vector<TankShell>& playerTankShells, Camera2D& camera, RandomStream& aiRandom) {
 
-    static mt19937 gen(random_device{}());  // Random number generator
-    static float accumulatedTime = 0.0f;   // Accumulated time for updates
+    float& accumulatedTime = allEnemyTanks.accumulatedTime;  // Accumulated time for updates
+    vector<int>& nearbyTanks = allEnemyTanks.nearbyTanks;    // Tank indices returned by the bucket grid
     accumulatedTime += deltaTime;          // Add deltaTime to accumulated time
 
-    if (allEnemyTanks.empty()) return;     // If no enemy tanks, return
+    if (allEnemyTanks.empty()) {           // If no enemy tanks, return
+        enemyGrid.clear();
+        return;
+    }
+
+    size_t count = allEnemyTanks.size();
+    Rectangle* posAndRects = allEnemyTanks.posAndRects.data();
+    Direction* currentDirections = allEnemyTanks.currentDirections.data();
 
-    // Update the center position of each enemy tank
-    for (auto& enemyTank : allEnemyTanks) {
-        enemyTank.centre = { enemyTank.posAndRect.x + enemyTank.posAndRect.width / 2,
-                             enemyTank.posAndRect.y + enemyTank.posAndRect.height / 2 };
+    // Remember where each tank was for the drawing
+    Vector2* previousPositions = allEnemyTanks.previousPositions.data();
+    for (size_t i = 0; i < count; i++) {
+        previousPositions[i] = { posAndRects[i].x, posAndRects[i].y };
     }
 
     // Update elapsed time for each enemy tank
     if (accumulatedTime >= 0.1f) {
-        for (auto& enemyTank : allEnemyTanks) {
-            enemyTank.elapsedTime += accumulatedTime;
+        float* elapsedTimes = allEnemyTanks.elapsedTimes.data();
+        for (size_t i = 0; i < count; i++) {
+            elapsedTimes[i] += accumulatedTime;
         }
         accumulatedTime = 0.0f;  // Reset accumulated time
     }
 
     // Handle shooting logic for enemy tanks
-    for (auto& enemyTank : allEnemyTanks) {
-        if (enemyTank.shootingInterval - 0.015f > 0) {
-            enemyTank.shootingInterval -= 0.015f;  // Decrease shooting interval
+    int* shotCountdowns = allEnemyTanks.shotCountdowns.data();
+    Vector2 viewCorner = GetScreenToWorld2D({ 0, 0 }, camera);  // Enemy shells fly as far as the top left corner of the view is from them
+    for (size_t i = 0; i < count; i++) {
+        if (shotCountdowns[i] > 1) {
+            shotCountdowns[i]--;
+            continue;  // Not time to shoot yet
         }
-        else {
-            enemyTank.shootingInterval = 1.30f;  // Reset shooting interval
 
-            // Create a new tank shell based on the current direction
-            switch (enemyTank.currentDirection) {
-            case UP:
-                playerTankShells.emplace_back(Vector2{ enemyTank.centre.x, enemyTank.posAndRect.y }, 0.0f, Vector2{ 0, 0 }, camera, ENEMYTANK);
-                break;
-            case RIGHT:
-                playerTankShells.emplace_back(Vector2{ enemyTank.posAndRect.x + enemyTank.posAndRect.width, enemyTank.centre.y }, 90.0f, Vector2{ 0, 0 }, camera, ENEMYTANK);
-                break;
-            case DOWN:
-                playerTankShells.emplace_back(Vector2{ enemyTank.centre.x, enemyTank.posAndRect.y + enemyTank.posAndRect.height }, 180.0f, Vector2{ 0, 0 }, camera, ENEMYTANK);
-                break;
-            case LEFT:
-                playerTankShells.emplace_back(Vector2{ enemyTank.posAndRect.x, enemyTank.centre.y }, 270.0f, Vector2{ 0, 0 }, camera, ENEMYTANK);
-                break;
-            }
+        int intervalTicks = max(1, (int)lroundf(allEnemyTanks.shootingIntervals[i] / 0.015f));  // The old countdown took 0.015 off every frame, keep its fire rate (87 ticks)
+        if (shotCountdowns[i] < 0) {
+            shotCountdowns[i] = intervalTicks;  // New tank, first shot after a whole interval
+            if (--shotCountdowns[i] > 0) continue;
+        }
+        shotCountdowns[i] = intervalTicks;  // Reset shooting countdown
+
+        // Create a new tank shell based on the current direction
+        const Rectangle& posAndRect = posAndRects[i];
+        Vector2 centre = allEnemyTanks.centre(i);
+        switch (currentDirections[i]) {
+        case UP:
+            playerTankShells.emplace_back(Vector2{ centre.x, posAndRect.y }, 0.0f, viewCorner, ENEMYTANK);
+            break;
+        case RIGHT:
+            playerTankShells.emplace_back(Vector2{ posAndRect.x + posAndRect.width, centre.y }, 90.0f, viewCorner, ENEMYTANK);
+            break;
+        case DOWN:
+            playerTankShells.emplace_back(Vector2{ centre.x, posAndRect.y + posAndRect.height }, 180.0f, viewCorner, ENEMYTANK);
+            break;
+        case LEFT:
+            playerTankShells.emplace_back(Vector2{ posAndRect.x, centre.y }, 270.0f, viewCorner, ENEMYTANK);
+            break;
         }
     }
 
     // Update guided direction based on player position
-    for (auto& enemyTank : allEnemyTanks) {
-        enemyTank.guidedDirection = (enemyTank.posAndRect.y > playerTankPositionY) ? UP : DOWN;
+    Direction* guidedDirections = allEnemyTanks.guidedDirections.data();
+    for (size_t i = 0; i < count; i++) {
+        guidedDirections[i] = (posAndRects[i].y > playerTankPositionY) ? UP : DOWN;
     }
 
     // Update direction for each enemy tank
-    for (auto& enemyTank : allEnemyTanks) {
-        if (enemyTank.elapsedTime >= enemyTank.timeLimit) {
-            enemyTank.elapsedTime = 0;  // Reset elapsed time
-            enemyTank.timeLimit = uniform_int_distribution<int>{ 2, 5 }(gen);  // Set new time limit
-
-            // Randomly choose a new direction based on guided direction
-            if (enemyTank.guidedDirection == UP) {
-                enemyTank.currentDirection = array{ RIGHT, LEFT, UP }[uniform_int_distribution<int>(0, 2)(gen)];
-            }
-            else {
-                enemyTank.currentDirection = array{ RIGHT, LEFT, DOWN }[uniform_int_distribution<int>(0, 2)(gen)];
-            }
+    for (size_t i = 0; i < count; i++) {
+        if (allEnemyTanks.elapsedTimes[i] < allEnemyTanks.timeLimits[i]) continue;
+
+        allEnemyTanks.elapsedTimes[i] = 0;  // Reset elapsed time
+        allEnemyTanks.timeLimits[i] = aiRandom.range(2, 5);  // Set new time limit
+
+        // Randomly choose a new direction based on guided direction
+        if (guidedDirections[i] == UP) {
+            currentDirections[i] = array{ RIGHT, LEFT, UP }[aiRandom.range(0, 2)];
+        }
+        else {
+            currentDirections[i] = array{ RIGHT, LEFT, DOWN }[aiRandom.range(0, 2)];
         }
     }
 
-    // Update position of each enemy tank
-    for (auto& enemyTank : allEnemyTanks) {
-        Rectangle newPosAndRect = enemyTank.posAndRect;  // New position and rectangle
+    // Index the tanks by position, a tank moved earlier in the loop is at most one step away from its bucket entry
+    rebuildEnemyGrid(enemyGrid, allEnemyTanks);
+    const float* speeds = allEnemyTanks.speeds.data();
+    float largestStep = 0.0f;  // Furthest any tank can move this frame
+    for (size_t i = 0; i < count; i++) {
+        largestStep = fmaxf(largestStep, speeds[i] * deltaTime);
+    }
 
-        bool hasRotationChanged = false;  // Whether rotation has changed
-        bool changeXorY = false;         // Whether to change X or Y position
-        float nextMove;                  // Next move position
+    // Update position of each enemy tank
+    for (size_t i = 0; i < count; i++) {
+        Rectangle newPosAndRect = posAndRects[i];  // New position and rectangle
+        float step = speeds[i] * deltaTime;  // Distance to move this tick
 
         // Calculate new position based on current direction
-        if (enemyTank.currentDirection == UP && enemyTank.posAndRect.y > 10) {
-            newPosAndRect.y -= enemyTank.Speed * deltaTime;
-            nextMove = newPosAndRect.y;
-            changeXorY = true;
-        }
-        else if (enemyTank.currentDirection == DOWN && enemyTank.posAndRect.y < canvasHeight - enemyTank.posAndRect.height - 10) {
-            newPosAndRect.y += enemyTank.Speed * deltaTime;
-            nextMove = newPosAndRect.y;
-            changeXorY = true;
-        }
-        else if (enemyTank.currentDirection == LEFT && enemyTank.posAndRect.x > 10) {
-            newPosAndRect.x -= enemyTank.Speed * deltaTime;
-            nextMove = newPosAndRect.x;
-        }
-        else if (enemyTank.currentDirection == RIGHT && enemyTank.posAndRect.x < CanvasWidth - enemyTank.posAndRect.width - 10) {
-            newPosAndRect.x += enemyTank.Speed * deltaTime;
-            nextMove = newPosAndRect.x;
-        }
-
-        bool collisionDetected = false;  // Whether collision is detected
-
-        // Check for collisions with obstacles
-        for (const auto& obs : obstacles) {
-            if (obs.type == BRICK || obs.type == BARRIER || obs.type == WATER) {
-                if (CheckCollisionRecs(newPosAndRect, obs.sizeAndPosition)) {
-                    collisionDetected = true;
-                    break;
-                }
-            }
+        if (currentDirections[i] == UP && posAndRects[i].y > 10) {
+            newPosAndRect.y -= step;
+        }
+        else if (currentDirections[i] == DOWN && posAndRects[i].y < canvasHeight - posAndRects[i].height - 10) {
+            newPosAndRect.y += step;
+        }
+        else if (currentDirections[i] == LEFT && posAndRects[i].x > 10) {
+            newPosAndRect.x -= step;
+        }
+        else if (currentDirections[i] == RIGHT && posAndRects[i].x < CanvasWidth - posAndRects[i].width - 10) {
+            newPosAndRect.x += step;
         }
 
         // Check for collision with player tank
         if (CheckCollisionRecs(newPosAndRect, playerTankRect)) {
-            collisionDetected = true;
             continue;
         }
 
-        // Check for collisions with other enemy tanks
-        if (!collisionDetected) {
-            for (auto& nextEnemyTank : allEnemyTanks) {
-                if (areRectanglesDifferent(enemyTank.posAndRect, nextEnemyTank.posAndRect) && CheckCollisionRecs(newPosAndRect, nextEnemyTank.posAndRect)) {
-                    Vector2 separationForce = Vector2{ nextEnemyTank.posAndRect.x - enemyTank.posAndRect.x, nextEnemyTank.posAndRect.y - enemyTank.posAndRect.y };
-                    float distance = sqrt(separationForce.x * separationForce.x + separationForce.y * separationForce.y);
-                    if (distance < 20.0f) {  // Apply separation force if too close
-                        newPosAndRect.x -= separationForce.x * 0.1f;
-                        newPosAndRect.y -= separationForce.y * 0.1f;
-                    }
-                    collisionDetected = true;
-                    break;
-                }
-            }
+        // Check for collisions with bricks, barriers and water
+        if (tilesBlockMove(tileMap, newPosAndRect, LAYER_ENEMY)) {
+            continue;
         }
 
-        // Update position if no collision detected
-        if (!collisionDetected) {
-            enemyTank.posAndRect = newPosAndRect;
+        // Check for collisions with the other enemy tanks near the new position
+        Rectangle searchArea = { newPosAndRect.x - largestStep, newPosAndRect.y - largestStep, newPosAndRect.width + largestStep * 2, newPosAndRect.height + largestStep * 2 };
+        if (findOverlappingEnemy(newPosAndRect, searchArea, allEnemyTanks, &posAndRects[i], enemyGrid, nearbyTanks) >= 0) {
+            continue;
         }
+
+        allEnemyTanks.setRect(i, newPosAndRect);  // Update position, nothing is in the way
     }
+
+    // Index the tanks at their new positions for the player tank and the next collision pass
+    rebuildEnemyGrid(enemyGrid, allEnemyTanks);
 }
 
-// Function to draw enemy tanks on the screen
-void drawEnemyTanks(vector<EnemyTank>& allEnemyTanks, Texture2D& enemyTankTexture) {
+#ifndef SIM_HEADLESS  // Drawing, only in the windowed game
+
+// Function to queue the enemy tanks on screen, alpha blends each tank between its last two ticks
+void drawEnemyTanks(EnemyTanks& allEnemyTanks, Sprite& enemyTankTexture, const Rectangle& view, RenderQueue& renderQueue, bool debugText, float alpha) {
+    float reach = fmaxf((float)enemyTankTexture.width, (float)enemyTankTexture.height) / 2.0f;  // Furthest the rotated texture reaches from the centre
+
     if (allEnemyTanks.size() > 0) {
-        for (auto& enemyTank : allEnemyTanks) {
-            // Draw the tank based on its current direction
-            switch (enemyTank.currentDirection) {
+        for (size_t i = 0; i < allEnemyTanks.size(); i++) {
+            const Rectangle& posAndRect = allEnemyTanks.posAndRects[i];
+            const Vector2& previousPosition = allEnemyTanks.previousPositions[i];
+            Vector2 centre = { previousPosition.x + posAndRect.width / 2, previousPosition.y + posAndRect.height / 2 };  // Centre at the last tick
+
+            // Skip the tanks whose texture and debug text are both off screen
+            Vector2 middle = {
+                previousPosition.x + (posAndRect.x - previousPosition.x) * alpha + posAndRect.width / 2,
+                previousPosition.y + (posAndRect.y - previousPosition.y) * alpha + posAndRect.height / 2
+            };
+            Rectangle textureBounds = { middle.x - reach, middle.y - reach, reach * 2, reach * 2 };
+            Rectangle textBounds = { centre.x - 50, centre.y - 100, 100, 40 };  // Room for the two direction words
+            if (!isVisible(unionRect(textureBounds, textBounds), view)) continue;
+
+            // Queue the tank based on its current direction
+            switch (allEnemyTanks.currentDirections[i]) {
             case UP:
-                DrawTexturePro(enemyTankTexture,
-                    { 0.0f, 0.0f, (float)enemyTankTexture.width, (float)enemyTankTexture.height },
-                    { enemyTank.posAndRect.x + enemyTank.posAndRect.width / 2, enemyTank.posAndRect.y + enemyTank.posAndRect.height / 2, (float)enemyTankTexture.width, (float)enemyTankTexture.height },
+                renderQueue.sprite(RENDER_TANKS, enemyTankTexture,
+                    { middle.x, middle.y, (float)enemyTankTexture.width, (float)enemyTankTexture.height },
                     { (float)enemyTankTexture.width / 2.0f, (float)enemyTankTexture.height / 2.0f },
                     0, WHITE);
                 break;
             case DOWN:
-                DrawTexturePro(enemyTankTexture,
-                    { 0.0f, 0.0f, (float)enemyTankTexture.width, (float)enemyTankTexture.height },
-                    { enemyTank.posAndRect.x + enemyTank.posAndRect.width / 2, enemyTank.posAndRect.y + enemyTank.posAndRect.height / 2, (float)enemyTankTexture.width, (float)enemyTankTexture.height },
+                renderQueue.sprite(RENDER_TANKS, enemyTankTexture,
+                    { middle.x, middle.y, (float)enemyTankTexture.width, (float)enemyTankTexture.height },
                     { (float)enemyTankTexture.width / 2.0f, (float)enemyTankTexture.height / 2.0f },
                     180, WHITE);
                 break;
             case LEFT:
-                DrawTexturePro(enemyTankTexture,
-                    { 0.0f, 0.0f, (float)enemyTankTexture.width, (float)enemyTankTexture.height },
-                    { enemyTank.posAndRect.x + enemyTank.posAndRect.width / 2, enemyTank.posAndRect.y + enemyTank.posAndRect.height / 2, (float)enemyTankTexture.width, (float)enemyTankTexture.height },
+                renderQueue.sprite(RENDER_TANKS, enemyTankTexture,
+                    { middle.x, middle.y, (float)enemyTankTexture.width, (float)enemyTankTexture.height },
                     { (float)enemyTankTexture.width / 2.0f, (float)enemyTankTexture.height / 2.0f },
                     270, WHITE);
                 break;
             case RIGHT:
-                DrawTexturePro(enemyTankTexture,
-                    { 0.0f, 0.0f, (float)enemyTankTexture.width, (float)enemyTankTexture.height },
-                    { enemyTank.posAndRect.x + enemyTank.posAndRect.width / 2, enemyTank.posAndRect.y + enemyTank.posAndRect.height / 2, (float)enemyTankTexture.width, (float)enemyTankTexture.height },
+                renderQueue.sprite(RENDER_TANKS, enemyTankTexture,
+                    { middle.x, middle.y, (float)enemyTankTexture.width, (float)enemyTankTexture.height },
                     { (float)enemyTankTexture.width / 2.0f, (float)enemyTankTexture.height / 2.0f },
                     90, WHITE);
                 break;
             }
 
-            // Draw direction text for debugging
-            DrawText(directionString[enemyTank.guidedDirection].c_str(), enemyTank.centre.x - 50, enemyTank.centre.y - 100, 20, BLACK);
-            DrawText((directionString[enemyTank.currentDirection]).c_str(), enemyTank.centre.x - 50, enemyTank.centre.y - 80, 20, BLACK);
+            // Queue direction text for debugging
+            if (!debugText) continue;
+            renderQueue.text(RENDER_HUD, directionString[allEnemyTanks.guidedDirections[i]], centre.x - 50, centre.y - 100, 20, BLACK);
+            renderQueue.text(RENDER_HUD, directionString[allEnemyTanks.currentDirections[i]], centre.x - 50, centre.y - 80, 20, BLACK);
         }
     }
 }
 
+#endif  // SIM_HEADLESS
+
 #endif
@@ -1,27 +1,34 @@
 #ifndef PLAYER_TANK_H  // Header guard to prevent multiple inclusions
 #define PLAYER_TANK_H
 
+#include "simTypes.h"  // Include the tick input, events and value types
+#ifndef SIM_HEADLESS
 #include "raylib.h"  // Include the main Raylib library
 #include "raymath.h"  // Include Raylib's math utilities
+#endif
 #include <iostream>  // Include the standard input/output library
 #include <vector>  // Include the vector library for dynamic arrays
 #include "GameStatus.h"  // Include the header for game status management
 #include "obstacles.h"  // Include the header for obstacles
 #include "EnemyTank.h"  // Include the header for enemy tanks
 #include "TankShell.h"  // Include the header for tank shells
+#ifndef SIM_HEADLESS
+#include "textureAtlas.h"  // Include the sprite atlas
+#include "renderQueue.h"  // Include the layered draw queue
+#endif
 
 class PlayerTank {
 private:
     float rotation;  // Current rotation of the tank
     float speed;  // Speed of the tank
-    float rotationSpeed = 20.0f;  // Speed at which the tank rotates
+    float rotationSpeed = 1200.0f;  // Speed at which the tank rotates in degrees per second (20 per tick)
 
-    Texture2D textures[12];  // Array to store the tank's animation frames
+    int bodyWidth = 83, bodyHeight = 87;  // Size of the tank body, taken from the sprites once they are loaded
+    int turretWidth = 99, turretHeight = 100;  // Size of the turret
     size_t currentFrame = 0;  // Current frame of the animation
     float animationTimer = 0;  // Timer for animation frame updates
     float frameTime;  // Time between animation frames
 
-    Texture2D turretTexture;  // Texture for the tank's turret
     Vector2 turretPosition;  // Position of the turret
     Vector2 turretOrigin;  // Origin point for the turret's rotation
     float turretAngle;  // Current angle of the turret
@@ -30,9 +37,15 @@ private:
 
     Vector2 shellOutPos;  // Position where shells are fired from
 
+    vector<int> nearbyTanks;  // Enemy tank indices returned by the bucket grid
+
     float startRotation = 0.0f;  // Initial rotation of the tank
     float tankSpeed = 385;  // Base speed of the tank
 
+#ifndef SIM_HEADLESS  // Sprites and sounds, only in the windowed game
+    Sprite textures[12];  // Array to store the tank's animation frames
+    Sprite turretTexture;  // Sprite for the tank's turret
+
 #define MAX_SOUNDS 20  // Maximum number of sound instances
 
     Sound shootingSound;  // Sound for shooting
@@ -49,32 +62,42 @@ private:
 
     Sound engineIdle;  // Sound for the tank's idle engine
     Sound engineMoving;  // Sound for the tank's moving engine
+#endif
 
 public:
     Vector2 position;  // Position of the tank
+    Vector2 previousPosition;  // Position at the previous tick, drawing blends from it to position
+    float previousRotation = 0.0f;  // Rotation at the previous tick
     Vector2 turretEnd;  // End position of the turret (for aiming)
     Rectangle tankRect;  // Bounding rectangle for the tank
 
     float health = 100.0f;  // Health of the tank
 
-    void drawHealthBar() {  // Function to draw the tank's health bar
-        DrawRectangle(tankRect.x + 1, tankRect.y - 24, health / 100.0f * tankRect.width - 2, 11.0f, MAROON);  // Draw the health bar
-        DrawRectangleLinesEx({ tankRect.x, tankRect.y - 25, tankRect.width, 13.0f }, 3.0f, DARKGREEN);  // Draw the health bar border
+#ifndef SIM_HEADLESS
+    void drawHealthBar(RenderQueue& renderQueue, float alpha) {  // Function to queue the tank's health bar, it moves with the drawn tank
+        Vector2 drawn = GetDrawPosition(alpha);  // Where the tank is drawn
+        float x = tankRect.x + drawn.x - position.x, y = tankRect.y + drawn.y - position.y;
+        renderQueue.rectangle(RENDER_HUD, { x + 1, y - 24, health / 100.0f * tankRect.width - 2, 11.0f }, MAROON);  // Queue the health bar
+        renderQueue.rectangleLines(RENDER_HUD, { x, y - 25, tankRect.width, 13.0f }, 3.0f, DARKGREEN);  // Queue the health bar border
     }
+#endif
 
     PlayerTank() {};  // Default constructor
 
     void initialise(float startX, float startY) {  // Function to initialize the tank
         position = { startX, startY };  // Set the initial position
         rotation = startRotation;  // Set the initial rotation
+        previousPosition = position;  // Nothing to blend from yet
+        previousRotation = rotation;
         speed = tankSpeed;  // Set the speed
 
-        tankRect = { position.x, position.y, (float)textures[0].width, (float)textures[0].height };  // Initialize the tank's bounding rectangle
+        tankRect = { position.x, position.y, (float)bodyWidth, (float)bodyHeight };  // Initialize the tank's bounding rectangle
 
         currentFrame = 0;  // Reset the animation frame
         animationTimer = 0.0f;  // Reset the animation timer
         frameTime = 0.01f;  // Set the time between frames
 
+#ifndef SIM_HEADLESS
         shootingSoundArray[0] = LoadSound("sounds/shot2.mp3");  // Load the shooting sound
 
         for (int i = 1; i < MAX_SOUNDS; i++) {  // Create aliases for the shooting sound
@@ -98,8 +121,11 @@ public:
 
         engineIdle = LoadSound("sounds/engineIdle.mp3");  // Load the idle engine sound
         engineMoving = LoadSound("sounds/engineMoving.mp3");  // Load the moving engine sound
+#endif
     }
 
+#ifndef SIM_HEADLESS
+
     void playHitSound() {  // Function to play the hitting sound
         PlaySound(hittingSoundArray[currentHittingSound]);  // Play the current hitting sound
         currentHittingSound++;  // Move to the next sound instance
@@ -121,20 +147,31 @@ public:
             currentEnemyDestroySoundSound = 0;
     }
 
-    void LoadTankTexture() {  // Function to load the tank's textures
+    void LoadTankTexture(TextureAtlas& atlas) {  // Function to add the tank's images to the sprite atlas
         for (int i = 0; i < 12; ++i) {  // Load all 12 animation frames
-            textures[i] = LoadTexture(TextFormat("img/playerTank/pixil-frame-%01d.png", i + 1));
+            atlas.add("player/frame" + to_string(i + 1), LoadImage(TextFormat("img/playerTank/pixil-frame-%01d.png", i + 1)));
+        }
+
+        atlas.add("player/turret", LoadImage("img/playerTank/turret.png"));  // Load the turret image
+    }
+
+    void useSprites(const TextureAtlas& atlas) {  // Function to pick the tank's sprites out of the built atlas
+        for (int i = 0; i < 12; ++i) {
+            textures[i] = atlas.get("player/frame" + to_string(i + 1));
         }
 
-        turretTexture = LoadTexture("img/playerTank/turret.png");  // Load the turret texture
+        turretTexture = atlas.get("player/turret");
 
         turretPosition = GetPosition();  // Set the turret's position
         turretOrigin = { turretTexture.width / 2.0f, turretTexture.height / 2.0f };  // Set the turret's origin
         turretOrigin.y += 17;  // Adjust the origin for proper alignment
+
+        bodyWidth = textures[0].width, bodyHeight = textures[0].height;  // The simulation only needs the sizes
+        turretWidth = turretTexture.width, turretHeight = turretTexture.height;
     }
 
-    void Update(float deltaTime, Vector2 mousePos, GameStatus& gameStatus, vector<TankShell>& playerTankShells, Camera2D& camera, int& canvasWidth, int& canvasHeight, vector<Obstacle>& obstacles, vector<EnemyTank>& allEnemyTanks) {  // Function to update the tank's state
-        if (!(IsKeyDown(KEY_W) || IsKeyDown(KEY_A) || IsKeyDown(KEY_S) || IsKeyDown(KEY_D))) {  // If no movement keys are pressed
+    void updateEngineSound(bool moving) {  // Function to keep the idle or the moving engine sound playing
+        if (!moving) {  // If no movement keys are pressed
             StopSound(engineMoving);  // Stop the moving engine sound
             if (!IsSoundPlaying(engineIdle)) {  // If the idle engine sound is not playing
                 PlaySound(engineIdle);  // Play the idle engine sound
@@ -146,99 +183,106 @@ public:
                 PlaySound(engineMoving);  // Play the moving engine sound
             }
         }
+    }
+#endif
+
+    void Update(float deltaTime, const SimInput& input, SimEvents& events, GameStatus& gameStatus, vector<TankShell>& playerTankShells, int& canvasWidth, int& canvasHeight, TileMap& tileMap, EnemyTanks& allEnemyTanks, EntityGrid& enemyGrid) {  // Function to update the tank's state by one fixed tick
+        previousPosition = position;  // Remember the last tick for the drawing
+        previousRotation = rotation;
+        float rotationStep = rotationSpeed * deltaTime;  // Degrees the tank can turn this tick
 
         // Handle tank rotation based on key inputs
-        if (IsKeyDown(KEY_W) && IsKeyDown(KEY_D)) {  // Move diagonally up-right
+        if (input.up && input.right) {  // Move diagonally up-right
             float targetRotation = 45.0f;  // Target rotation angle
             float deltaRotation = targetRotation - rotation;  // Difference between current and target rotation
             if (deltaRotation > 180.0f) deltaRotation -= 360.0f;  // Adjust for circular rotation
             else if (deltaRotation < -180.0f) deltaRotation += 360.0f;  // Adjust for circular rotation
-            if (fabs(deltaRotation) > rotationSpeed) {  // If the difference is greater than the rotation speed
-                rotation += (deltaRotation > 0.0f) ? rotationSpeed : -rotationSpeed;  // Rotate towards the target
+            if (fabs(deltaRotation) > rotationStep) {  // If the difference is greater than this tick's turn
+                rotation += (deltaRotation > 0.0f) ? rotationStep : -rotationStep;  // Rotate towards the target
             }
             else {
                 rotation = targetRotation;  // Set the rotation to the target
             }
         }
-        else if (IsKeyDown(KEY_W) && IsKeyDown(KEY_A)) {  // Move diagonally up-left
+        else if (input.up && input.left) {  // Move diagonally up-left
             float targetRotation = 315.0f;
             float deltaRotation = targetRotation - rotation;
             if (deltaRotation > 180.0f) deltaRotation -= 360.0f;
             else if (deltaRotation < -180.0f) deltaRotation += 360.0f;
-            if (fabs(deltaRotation) > rotationSpeed) {
-                rotation += (deltaRotation > 0.0f) ? rotationSpeed : -rotationSpeed;
+            if (fabs(deltaRotation) > rotationStep) {
+                rotation += (deltaRotation > 0.0f) ? rotationStep : -rotationStep;
             }
             else {
                 rotation = targetRotation;
             }
         }
-        else if (IsKeyDown(KEY_S) && IsKeyDown(KEY_D)) {  // Move diagonally down-right
+        else if (input.down && input.right) {  // Move diagonally down-right
             float targetRotation = 135.0f;
             float deltaRotation = targetRotation - rotation;
             if (deltaRotation > 180.0f) deltaRotation -= 360.0f;
             else if (deltaRotation < -180.0f) deltaRotation += 360.0f;
-            if (fabs(deltaRotation) > rotationSpeed) {
-                rotation += (deltaRotation > 0.0f) ? rotationSpeed : -rotationSpeed;
+            if (fabs(deltaRotation) > rotationStep) {
+                rotation += (deltaRotation > 0.0f) ? rotationStep : -rotationStep;
             }
             else {
                 rotation = targetRotation;
             }
         }
-        else if (IsKeyDown(KEY_S) && IsKeyDown(KEY_A)) {  // Move diagonally down-left
+        else if (input.down && input.left) {  // Move diagonally down-left
             float targetRotation = 225.0f;
             float deltaRotation = targetRotation - rotation;
             if (deltaRotation > 180.0f) deltaRotation -= 360.0f;
             else if (deltaRotation < -180.0f) deltaRotation += 360.0f;
-            if (fabs(deltaRotation) > rotationSpeed) {
-                rotation += (deltaRotation > 0.0f) ? rotationSpeed : -rotationSpeed;
+            if (fabs(deltaRotation) > rotationStep) {
+                rotation += (deltaRotation > 0.0f) ? rotationStep : -rotationStep;
             }
             else {
                 rotation = targetRotation;
             }
         }
-        else if (IsKeyDown(KEY_W)) {  // Move up
+        else if (input.up) {  // Move up
             float targetRotation = 0.0f;
             float deltaRotation = targetRotation - rotation;
             if (deltaRotation > 180.0f) deltaRotation -= 360.0f;
             else if (deltaRotation < -180.0f) deltaRotation += 360.0f;
-            if (fabs(deltaRotation) > rotationSpeed) {
-                rotation += (deltaRotation > 0.0f) ? rotationSpeed : -rotationSpeed;
+            if (fabs(deltaRotation) > rotationStep) {
+                rotation += (deltaRotation > 0.0f) ? rotationStep : -rotationStep;
             }
             else {
                 rotation = targetRotation;
             }
         }
-        else if (IsKeyDown(KEY_A)) {  // Move left
+        else if (input.left) {  // Move left
             float targetRotation = 270.0f;
             float deltaRotation = targetRotation - rotation;
             if (deltaRotation > 180.0f) deltaRotation -= 360.0f;
             else if (deltaRotation < -180.0f) deltaRotation += 360.0f;
-            if (fabs(deltaRotation) > rotationSpeed) {
-                rotation += (deltaRotation > 0.0f) ? rotationSpeed : -rotationSpeed;
+            if (fabs(deltaRotation) > rotationStep) {
+                rotation += (deltaRotation > 0.0f) ? rotationStep : -rotationStep;
             }
             else {
                 rotation = targetRotation;
             }
         }
-        else if (IsKeyDown(KEY_S)) {  // Move down
+        else if (input.down) {  // Move down
             float targetRotation = 180.0f;
             float deltaRotation = targetRotation - rotation;
             if (deltaRotation > 180.0f) deltaRotation -= 360.0f;
             else if (deltaRotation < -180.0f) deltaRotation += 360.0f;
-            if (fabs(deltaRotation) > rotationSpeed) {
-                rotation += (deltaRotation > 0.0f) ? rotationSpeed : -rotationSpeed;
+            if (fabs(deltaRotation) > rotationStep) {
+                rotation += (deltaRotation > 0.0f) ? rotationStep : -rotationStep;
             }
             else {
                 rotation = targetRotation;
             }
         }
-        else if (IsKeyDown(KEY_D)) {  // Move right
+        else if (input.right) {  // Move right
             float targetRotation = 90.0f;
             float deltaRotation = targetRotation - rotation;
             if (deltaRotation > 180.0f) deltaRotation -= 360.0f;
             else if (deltaRotation < -180.0f) deltaRotation += 360.0f;
-            if (fabs(deltaRotation) > rotationSpeed) {
-                rotation += (deltaRotation > 0.0f) ? rotationSpeed : -rotationSpeed;
+            if (fabs(deltaRotation) > rotationStep) {
+                rotation += (deltaRotation > 0.0f) ? rotationStep : -rotationStep;
             }
             else {
                 rotation = targetRotation;
@@ -246,47 +290,36 @@ public:
         }
 
         // Handle tank movement
-        if (IsKeyDown(KEY_W) || IsKeyDown(KEY_A) || IsKeyDown(KEY_S) || IsKeyDown(KEY_D)) {  // If any movement key is pressed
+        if (input.moving()) {  // If any movement key is pressed
             Vector2 potentialPosition = {  // Calculate the potential new position
                 position.x + speed * cosf((rotation - 90.0f) * DEG2RAD) * deltaTime,
                 position.y + speed * sinf((rotation - 90.0f) * DEG2RAD) * deltaTime
             };
 
             Rectangle tankBoundingBox = {  // Create a bounding box for collision detection
-                potentialPosition.x - textures[currentFrame].width / 2,
-                potentialPosition.y - textures[currentFrame].height / 2,
-                static_cast<float>(textures[currentFrame].width),
-                static_cast<float>(textures[currentFrame].height)
+                potentialPosition.x - bodyWidth / 2,
+                potentialPosition.y - bodyHeight / 2,
+                static_cast<float>(bodyWidth),
+                static_cast<float>(bodyHeight)
             };
 
-            bool collisionDetected = false;  // Flag to check for collisions
-            for (const auto& obs : obstacles) {  // Check for collisions with obstacles
-                if (obs.type == BRICK || obs.type == BARRIER || obs.type == WATER) {
-                    if (CheckCollisionRecs(tankBoundingBox, obs.sizeAndPosition)) {
-                        collisionDetected = true;
-                        break;
-                    }
-                }
-            }
+            bool collisionDetected = tilesBlockMove(tileMap, tankBoundingBox, LAYER_PLAYER);  // Check for collisions with bricks, barriers and water
 
-            for (auto& enemyTank : allEnemyTanks) {  // Check for collisions with enemy tanks
-                if (CheckCollisionRecs(tankBoundingBox, enemyTank.posAndRect)) {
-                    collisionDetected = true;
-                    break;
-                }
+            if (findOverlappingEnemy(tankBoundingBox, tankBoundingBox, allEnemyTanks, nullptr, enemyGrid, nearbyTanks) >= 0) {  // Check for collisions with enemy tanks
+                collisionDetected = true;
             }
 
             if (!collisionDetected) {  // If no collision is detected
                 // Adjust position to stay within the canvas boundaries
-                if (tankBoundingBox.x < 0) potentialPosition.x = textures[currentFrame].width / 2;
-                if (tankBoundingBox.y < 0) potentialPosition.y = textures[currentFrame].height / 2;
-                if (tankBoundingBox.x + tankBoundingBox.width > canvasWidth) potentialPosition.x = canvasWidth - textures[currentFrame].width / 2;
-                if (tankBoundingBox.y + tankBoundingBox.height > canvasHeight) potentialPosition.y = canvasHeight - textures[currentFrame].height / 2;
+                if (tankBoundingBox.x < 0) potentialPosition.x = bodyWidth / 2;
+                if (tankBoundingBox.y < 0) potentialPosition.y = bodyHeight / 2;
+                if (tankBoundingBox.x + tankBoundingBox.width > canvasWidth) potentialPosition.x = canvasWidth - bodyWidth / 2;
+                if (tankBoundingBox.y + tankBoundingBox.height > canvasHeight) potentialPosition.y = canvasHeight - bodyHeight / 2;
 
                 position = potentialPosition;  // Update the tank's position
 
                 // Update the animation frame
-                animationTimer += GetFrameTime();
+                animationTimer += deltaTime;
                 if (animationTimer >= frameTime) {
                     currentFrame = (currentFrame + 1) % 12;
                     animationTimer = 0.0f;
@@ -294,7 +327,7 @@ public:
             }
         }
 
-        mousePosXY = mousePos;  // Update the mouse position
+        mousePosXY = input.aim;  // Update the aim position
 
         turretPosition = GetPosition();  // Update the turret's position
 
@@ -302,45 +335,49 @@ public:
         turretAngle = atan2(mousePosXY.y - turretPosition.y, mousePosXY.x - turretPosition.x) * RAD2DEG + 90;
 
         // Calculate the end point of the turret for aiming
-        turretEnd = CalculateTopMidPoint(turretPosition, turretTexture.width, turretTexture.height + 32, turretAngle);
+        turretEnd = CalculateTopMidPoint(turretPosition, turretWidth, turretHeight + 32, turretAngle);
 
         // Handle shooting
-        if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) {  // If the left mouse button is pressed
-            playerTankShells.emplace_back(turretEnd, turretAngle, mousePosXY, camera, PLAYERTANK);  // Create a new tank shell
-            playShootSound();  // Play the shooting sound
+        if (input.fire) {  // If fire was pressed since the last tick
+            playerTankShells.emplace_back(turretEnd, turretAngle, mousePosXY, PLAYERTANK);  // Create a new tank shell
+            events.push_back({ SIM_EVENT_SHELL_FIRED, turretEnd });  // The front end plays the shooting sound
         }
 
         // Update the tank's bounding rectangle
-        tankRect = { position.x - (float)textures[0].width / 2.0f, position.y - (float)textures[0].height / 2.0f, (float)textures[0].width, (float)textures[0].height };
+        tankRect = { position.x - (float)bodyWidth / 2.0f, position.y - (float)bodyHeight / 2.0f, (float)bodyWidth, (float)bodyHeight };
     }
 
-    void Draw() {  // Function to draw the tank
-        Texture2D currentTexture = textures[currentFrame];  // Get the current animation frame
+#ifndef SIM_HEADLESS
+    void Draw(RenderQueue& renderQueue, bool debugMarker, float alpha) {  // Function to queue the tank, alpha blends it between its last two ticks
+        const Sprite& currentTexture = textures[currentFrame];  // Get the current animation frame
 
         Vector2 origin = { (float)currentTexture.width / 2.0f, (float)currentTexture.height / 2.0f };  // Set the origin for rotation
 
-        Rectangle source = { 0.0f, 0.0f, (float)currentTexture.width, (float)currentTexture.height };  // Define the source rectangle for the texture
+        Vector2 drawn = GetDrawPosition(alpha);  // Where the tank is between the ticks
+        Rectangle dest = { drawn.x, drawn.y, (float)currentTexture.width, (float)currentTexture.height };  // Define the destination rectangle for the texture
 
-        Rectangle dest = { position.x, position.y, (float)currentTexture.width, (float)currentTexture.height };  // Define the destination rectangle for the texture
+        float turn = fmodf(rotation - previousRotation + 540.0f, 360.0f) - 180.0f;  // Shortest way from the previous rotation
+        renderQueue.sprite(RENDER_TANKS, currentTexture, dest, origin, previousRotation + turn * alpha, WHITE);  // Queue the tank
 
-        DrawTexturePro(currentTexture, source, dest, origin, rotation, WHITE);  // Draw the tank
-
-        // Draw the turret
-        DrawTexturePro(
+        // Queue the turret
+        renderQueue.sprite(
+            RENDER_TANKS,
             turretTexture,
-            { 0, 0, (float)turretTexture.width, (float)turretTexture.height },
-            { turretPosition.x, turretPosition.y, (float)turretTexture.width, (float)turretTexture.height },
+            { drawn.x, drawn.y, (float)turretTexture.width, (float)turretTexture.height },
             turretOrigin,
             turretAngle,
             WHITE
         );
 
-        DrawCircleV(turretEnd, 5, BLUE);  // Draw a circle at the end of the turret for debugging
+        if (debugMarker) {
+            renderQueue.circle(RENDER_HUD, turretEnd, 5, BLUE);  // Queue a circle at the end of the turret for debugging
+        }
     }
 
     void drawDebug() {  // Function to draw debug information
         DrawText(TextFormat("FPS: %d", GetFPS()), 50, 10, 40, DARKGRAY);  // Display the current FPS
     }
+#endif
 
     Vector2 CalculateTopMidPoint(Vector2 center, float width, float height, float angle) const {  // Function to calculate the top midpoint of the turret
         float radians = angle * DEG2RAD;  // Convert the angle to radians
@@ -381,17 +418,16 @@ public:
         return position;
     }
 
+    Vector2 GetDrawPosition(float alpha) const {  // Function to get the tank's position between its last two ticks
+        return { previousPosition.x + (position.x - previousPosition.x) * alpha, previousPosition.y + (position.y - previousPosition.y) * alpha };
+    }
+
     float GetRotation() const {  // Function to get the tank's rotation
         return rotation;
     }
 
     ~PlayerTank() {  // Destructor to clean up resources
-        for (int i = 0; i < 12; ++i) {  // Unload all animation frames
-            UnloadTexture(textures[i]);
-        }
-
-        UnloadTexture(turretTexture);  // Unload the turret texture
-
+#ifndef SIM_HEADLESS
         for (int i = 1; i < MAX_SOUNDS; i++)  // Unload all shooting sound aliases
             UnloadSoundAlias(shootingSoundArray[i]);
         UnloadSound(shootingSoundArray[0]);  // Unload the original shooting sound
@@ -402,6 +438,7 @@ public:
 
         UnloadSound(engineIdle);  // Unload the idle engine sound
         UnloadSound(engineMoving);  // Unload the moving engine sound
+#endif
     }
 };
 
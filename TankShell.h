@@ -1,6 +1,13 @@
 #ifndef TANK_SHELL_H
 #define TANK_SHELL_H
 
+#include "simTypes.h"  // Value types, from raylib unless built headless
+#include <cmath>  // Standard math functions (sqrtf, cos, sin)
+#ifndef SIM_HEADLESS
+#include "textureAtlas.h"  // Sprite type used to draw the shell
+#include "renderQueue.h"  // Layered draw queue
+#endif
+
 // Define an enumeration for the type of shooter (player or enemy)
 enum bulletShooterType {
     PLAYERTANK,  // Represents a shell shot by the player tank
@@ -17,13 +24,14 @@ private:
 public:
     float shellDeltaTime;  // Delta time for the shell's movement
     Vector2 position;      // Current position of the shell
+    Vector2 previousPosition; // Position at the previous tick, drawing blends from it to position
 
     Vector2 shellTip;      // The tip of the shell (used for collision detection)
 
     Vector2 direction;     // Direction vector of the shell's movement
     float speed = 750.0f;  // Speed of the shell
     Vector2 StartPosition; // Initial position of the shell
-    float distanceTraveled; // Distance traveled by the shell
+    float distanceTraveled = 0.0f; // Distance traveled by the shell
     float maxDistance;     // Maximum distance the shell can travel
     Vector2 target;        // Target position of the shell
 
@@ -31,6 +39,13 @@ public:
 
     bulletShooterType shooter; // Type of shooter (player or enemy)
 
+    float impactDistance = INFINITY; // Distance along the path at which the shell hits a tile (INFINITY if it hits none)
+    int impactColumn = -1;   // Column of the tile the shell will hit
+    int impactRow = -1;      // Row of the tile the shell will hit
+    bool impactDirty = true; // Whether the impact point has to be (re)computed
+
+    bool spent = false;      // Set when the shell explodes, the shell is removed at the end of the collision pass
+
     // Set the position of the shell
     void setPosition(Vector2 newPos) {
         position = newPos;
@@ -47,8 +62,9 @@ public:
     }
 
     // Constructor for the TankShell class
-    TankShell(Vector2 startPos, float angle, Vector2 mousePos, Camera2D& camera, bulletShooterType whoShot)
-        : position(startPos), StartPosition(startPos), rotation(angle), target(mousePos), shooter(whoShot) {
+    // targetPos is a point in the world, the shell flies as far as it is from the start
+    TankShell(Vector2 startPos, float angle, Vector2 targetPos, bulletShooterType whoShot)
+        : position(startPos), previousPosition(startPos), StartPosition(startPos), rotation(angle), target(targetPos), shooter(whoShot) {
 
         // Calculate the direction vector based on the angle
         direction = {
@@ -58,15 +74,16 @@ public:
 
         // Calculate the maximum distance the shell can travel
         maxDistance = sqrtf(
-            pow(StartPosition.x - GetScreenToWorld2D(target, camera).x, 2) +  // Calculate x-distance
-            pow(StartPosition.y - GetScreenToWorld2D(target, camera).y, 2)    // Calculate y-distance
+            pow(StartPosition.x - target.x, 2) +  // Calculate x-distance
+            pow(StartPosition.y - target.y, 2)    // Calculate y-distance
         );
     }
 
     // Update the shell's position and state
-    void Update(float& deltaTime, Camera2D& camera) {
+    void Update(float& deltaTime) {
 
         shellDeltaTime = deltaTime;  // Update delta time
+        previousPosition = position;  // Remember where the shell was for the drawing
 
         // Calculate the potential next position of the shell
         potentialPosition = {
@@ -80,18 +97,21 @@ public:
             pow(StartPosition.y - potentialPosition.y, 2)    // Calculate y-distance
         );
 
-        // Check if the shell has exceeded its maximum travel distance
-        if (newDistanceTraveled >= maxDistance) {
+        // The shell stops at its impact point if that comes before its maximum distance
+        float stopDistance = impactDistance < maxDistance ? impactDistance : maxDistance;
+
+        // Check if the shell has exceeded its travel distance
+        if (newDistanceTraveled >= stopDistance) {
             // Calculate the overshoot distance
-            float overshoot = newDistanceTraveled - maxDistance;
+            float overshoot = newDistanceTraveled - stopDistance;
             // Calculate the adjustment factor to stop the shell at the max distance
-            float adjustmentFactor = (newDistanceTraveled - overshoot) / newDistanceTraveled;
-            // Adjust the position to stop at the max distance
+            float adjustmentFactor = newDistanceTraveled > 0.0f ? (newDistanceTraveled - overshoot) / newDistanceTraveled : 0.0f;
+            // Adjust the position to stop at the stop distance
             position = {
                 StartPosition.x + (potentialPosition.x - StartPosition.x) * adjustmentFactor,
                 StartPosition.y + (potentialPosition.y - StartPosition.y) * adjustmentFactor
             };
-            distanceTraveled = maxDistance;  // Set distance traveled to max distance
+            distanceTraveled = stopDistance;  // Set distance traveled to the stop distance
             return;  // Exit the function
         }
 
@@ -100,18 +120,27 @@ public:
         distanceTraveled = newDistanceTraveled;
     }
 
-    // Draw the shell on the screen
-    void Draw(Texture2D shellTexture) {
-        Rectangle source = { 0.0f, 0.0f, (float)shellTexture.width, (float)shellTexture.height };  // Source rectangle for the texture
-        Rectangle dest = { position.x, position.y, (float)shellTexture.width, (float)shellTexture.height };  // Destination rectangle for the texture
+    // Check whether the shell has arrived at the tile it hits
+    bool reachedImpact() const {
+        return distanceTraveled >= impactDistance;
+    }
+
+#ifndef SIM_HEADLESS  // Drawing, only in the windowed game
+    // Draw the shell on the screen, alpha blends it between its last two ticks
+    void Draw(const Sprite& shellTexture, RenderQueue& renderQueue, float alpha) {
+        Vector2 drawPosition = {  // Where the shell is between the ticks
+            previousPosition.x + (position.x - previousPosition.x) * alpha,
+            previousPosition.y + (position.y - previousPosition.y) * alpha
+        };
+        Rectangle dest = { drawPosition.x, drawPosition.y, (float)shellTexture.width, (float)shellTexture.height };  // Destination rectangle for the texture
         Vector2 origin = { (float)shellTexture.width / 2.0f, (float)shellTexture.height / 2.0f };  // Origin for rotation
-        DrawTexturePro(shellTexture, source, dest, origin, rotation, WHITE);  // Draw the rotated texture
+        renderQueue.sprite(RENDER_SHELLS, shellTexture, dest, origin, rotation, WHITE);  // Queue the rotated sprite
 
         shellTip = GetTopEdgeMidpoint(shellTexture);  // Update the shell tip position
     }
 
     // Calculate the midpoint of the top edge of the shell texture
-    Vector2 GetTopEdgeMidpoint(Texture2D shellTexture) const {
+    Vector2 GetTopEdgeMidpoint(const Sprite& shellTexture) const {
         Vector2 topEdgeMid = { position.x, position.y - shellTexture.height / 2.0f };  // Calculate the midpoint of the top edge
 
         float radians = rotation * DEG2RAD;  // Convert rotation to radians
@@ -126,6 +155,7 @@ public:
 
         return rotatedMidpoint;  // Return the rotated midpoint
     }
+#endif
 
     // Get the current position of the shell
     Vector2 GetPosition() const {
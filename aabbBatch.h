@@ -0,0 +1,131 @@
+#ifndef AABB_BATCH_H
+#define AABB_BATCH_H
+
+// Include necessary libraries and headers
+#include "simTypes.h"  // Rectangle type, from raylib unless built headless
+#include <vector>    // Standard vector container
+
+// Pick the widest instruction set the compiler was told it can use
+#if defined(__AVX__)
+#define AABB_BATCH_AVX  // 8 rectangles per step
+#include <immintrin.h>  // AVX intrinsics
+#elif defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define AABB_BATCH_SSE  // 4 rectangles per step
+#include <xmmintrin.h>  // SSE intrinsics
+#endif
+
+using namespace std;  // Use the standard namespace
+
+// Define the RectBatch class
+// Rectangles stored as separate arrays of edges (structure of arrays), so one query can be tested against
+// 4 (SSE) or 8 (AVX) of them with a single compare per edge. The owner keeps it in step with its own list
+// (same positions), so it is filled once rather than gathered for every query.
+class RectBatch {
+public:
+    vector<float> minX;  // Left edge of each rectangle
+    vector<float> minY;  // Top edge of each rectangle
+    vector<float> maxX;  // Right edge of each rectangle
+    vector<float> maxY;  // Bottom edge of each rectangle
+
+    // Remove every rectangle (keeps the memory)
+    void clear() {
+        minX.clear();
+        minY.clear();
+        maxX.clear();
+        maxY.clear();
+    }
+
+    // Add a rectangle at the end
+    void push(const Rectangle& rect) {
+        minX.push_back(rect.x);
+        minY.push_back(rect.y);
+        maxX.push_back(rect.x + rect.width);  // Same sums CheckCollisionRecs computes, so results match it exactly
+        maxY.push_back(rect.y + rect.height);
+    }
+
+    // Replace the rectangle at a position (e.g. after it moved)
+    void set(int i, const Rectangle& rect) {
+        minX[i] = rect.x;
+        minY[i] = rect.y;
+        maxX[i] = rect.x + rect.width;
+        maxY[i] = rect.y + rect.height;
+    }
+
+    // Remove the rectangle at a position by moving the last one into it
+    void removeAt(int i) {
+        int last = size() - 1;
+        minX[i] = minX[last];
+        minY[i] = minY[last];
+        maxX[i] = maxX[last];
+        maxY[i] = maxY[last];
+        minX.pop_back();
+        minY.pop_back();
+        maxX.pop_back();
+        maxY.pop_back();
+    }
+
+    // Get the number of rectangles in the batch
+    int size() const {
+        return (int)minX.size();
+    }
+};
+
+// Function to test one rectangle of the batch against the query edges (same strict test as CheckCollisionRecs)
+inline bool overlapsOne(const RectBatch& batch, int i, float queryMinX, float queryMinY, float queryMaxX, float queryMaxY) {
+    return queryMinX < batch.maxX[i] && queryMaxX > batch.minX[i] && queryMinY < batch.maxY[i] && queryMaxY > batch.minY[i];
+}
+
+// Function to get a bit mask of the batch rectangles first..first+7 that overlap the query (bit n is rectangle first+n)
+// Only the rectangles that exist are tested, so the last step of a batch may have fewer than 8 bits.
+inline unsigned overlapMask(const Rectangle& query, const RectBatch& batch, int first) {
+    float queryMinX = query.x, queryMinY = query.y;  // Edges of the query rectangle
+    float queryMaxX = query.x + query.width, queryMaxY = query.y + query.height;
+    int count = batch.size() - first;  // Rectangles left in the batch
+
+#if defined(AABB_BATCH_AVX)
+    if (count >= 8) {
+        __m256 qMinX = _mm256_set1_ps(queryMinX), qMinY = _mm256_set1_ps(queryMinY);  // Query edges in every lane
+        __m256 qMaxX = _mm256_set1_ps(queryMaxX), qMaxY = _mm256_set1_ps(queryMaxY);
+        __m256 hit = _mm256_and_ps(
+            _mm256_and_ps(_mm256_cmp_ps(qMinX, _mm256_loadu_ps(&batch.maxX[first]), _CMP_LT_OQ), _mm256_cmp_ps(qMaxX, _mm256_loadu_ps(&batch.minX[first]), _CMP_GT_OQ)),
+            _mm256_and_ps(_mm256_cmp_ps(qMinY, _mm256_loadu_ps(&batch.maxY[first]), _CMP_LT_OQ), _mm256_cmp_ps(qMaxY, _mm256_loadu_ps(&batch.minY[first]), _CMP_GT_OQ)));
+        return (unsigned)_mm256_movemask_ps(hit);  // One bit per lane
+    }
+#elif defined(AABB_BATCH_SSE)
+    if (count >= 4) {
+        __m128 qMinX = _mm_set1_ps(queryMinX), qMinY = _mm_set1_ps(queryMinY);  // Query edges in every lane
+        __m128 qMaxX = _mm_set1_ps(queryMaxX), qMaxY = _mm_set1_ps(queryMaxY);
+        unsigned mask = 0;
+        for (int step = 0; step < 8 && step + 4 <= count; step += 4) {  // Two steps of 4 make up the 8 bits
+            int i = first + step;
+            __m128 hit = _mm_and_ps(
+                _mm_and_ps(_mm_cmplt_ps(qMinX, _mm_loadu_ps(&batch.maxX[i])), _mm_cmpgt_ps(qMaxX, _mm_loadu_ps(&batch.minX[i]))),
+                _mm_and_ps(_mm_cmplt_ps(qMinY, _mm_loadu_ps(&batch.maxY[i])), _mm_cmpgt_ps(qMaxY, _mm_loadu_ps(&batch.minY[i]))));
+            mask |= (unsigned)_mm_movemask_ps(hit) << step;  // One bit per lane
+        }
+        for (int step = count >= 8 ? 8 : 4; step < 8 && step < count; step++) {  // Fewer than 4 left in the second half
+            if (overlapsOne(batch, first + step, queryMinX, queryMinY, queryMaxX, queryMaxY)) mask |= 1u << step;
+        }
+        return mask;
+    }
+#endif
+
+    // Scalar fallback (no SIMD, or the tail of the batch)
+    unsigned mask = 0;
+    for (int step = 0; step < 8 && step < count; step++) {
+        if (overlapsOne(batch, first + step, queryMinX, queryMinY, queryMaxX, queryMaxY)) mask |= 1u << step;
+    }
+    return mask;
+}
+
+// Function to get the lane of the lowest set bit of a non-zero mask (the earliest rectangle of the step)
+inline int lowestLane(unsigned mask) {
+    int lane = 0;
+    while (!(mask & 1)) {
+        mask >>= 1;
+        lane++;
+    }
+    return lane;
+}
+
+#endif
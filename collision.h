@@ -0,0 +1,62 @@
+#ifndef COLLISION_H
+#define COLLISION_H
+
+// Include necessary libraries and headers
+#include "simTypes.h" // Rectangle type, from raylib unless built headless
+#include "tileMap.h"  // Tile flags used to test against the world
+
+// Define the collision layers, one bit each so a mask can hold several
+enum CollisionLayer : unsigned char {
+    LAYER_PLAYER = 1,        // The player tank
+    LAYER_ENEMY = 2,         // Enemy tanks
+    LAYER_PLAYER_SHELL = 4,  // Shells fired by the player
+    LAYER_ENEMY_SHELL = 8,   // Shells fired by enemy tanks
+    LAYER_SOLID_TILE = 16,   // Bricks and barriers
+    LAYER_WATER_TILE = 32    // Water
+};
+
+// Function to get the layers that an object on the given layer collides with
+unsigned char collisionMask(CollisionLayer layer) {
+    switch (layer) {
+    case LAYER_PLAYER:
+        return LAYER_ENEMY | LAYER_ENEMY_SHELL | LAYER_SOLID_TILE | LAYER_WATER_TILE;
+    case LAYER_ENEMY:
+        return LAYER_PLAYER | LAYER_ENEMY | LAYER_PLAYER_SHELL | LAYER_SOLID_TILE | LAYER_WATER_TILE;
+    case LAYER_PLAYER_SHELL:
+        return LAYER_ENEMY | LAYER_SOLID_TILE;  // Shells fly over water and ignore the shooter's side
+    case LAYER_ENEMY_SHELL:
+        return LAYER_PLAYER | LAYER_SOLID_TILE;
+    case LAYER_SOLID_TILE:
+        return LAYER_PLAYER | LAYER_ENEMY | LAYER_PLAYER_SHELL | LAYER_ENEMY_SHELL;
+    case LAYER_WATER_TILE:
+        return LAYER_PLAYER | LAYER_ENEMY;
+    }
+    return 0;
+}
+
+// Function to check whether two layers collide
+bool layersCollide(CollisionLayer first, CollisionLayer second) {
+    return (collisionMask(first) & second) != 0;
+}
+
+// Function to get the tile flag of the tiles that block an object on the given layer
+TileFlag tileFlagFor(CollisionLayer layer) {
+    return (collisionMask(layer) & LAYER_WATER_TILE) ? TILE_BLOCKS_TANKS : TILE_BLOCKS_SHELLS;
+}
+
+// Function to check whether the tiles stop an object on the given layer from moving into a rectangle
+bool tilesBlockMove(const TileMap& tileMap, const Rectangle& moveRect, CollisionLayer layer) {
+    return tileMap.overlaps(moveRect, tileFlagFor(layer));
+}
+
+// Define a contact found by the collision phase, the effects are applied afterwards in one pass
+struct ContactEvent {
+    CollisionLayer layer;       // Layer of the object that ran into something (a shell)
+    int index;                  // Index of that object in its list
+    CollisionLayer otherLayer;  // Layer of what it ran into
+    int otherIndex;             // Index of the tank it ran into (-1 for tiles)
+    int column;                 // Tile it ran into (-1 for tanks)
+    int row;
+};
+
+#endif
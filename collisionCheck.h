@@ -0,0 +1,548 @@
+#ifndef COLLISION_CHECK_H
+#define COLLISION_CHECK_H
+
+// Self check for the collision structures, built in when COLLISION_SELF_CHECK is defined (see main.cpp).
+// Loads the real map, then fires random tank moves, shell paths, enemy queries and brick destructions at both
+// the fast path (tile masks, DDA sweep, bucket grid, batched kernel) and plain loops over every obstacle rectangle,
+// the way the game used to test them. The rectangles are expanded from the obstacle map on their own, not read back
+// from the tile map. A second pass runs shells and player tank moves through the game's own update and collision phase.
+// Stops at the first query where the answers differ.
+
+// Include necessary libraries and headers
+#include "simTypes.h"    // Value types, from raylib unless built headless
+#include "PlayerTank.h"  // Player tank first, it pulls in the enemy tanks in the order they need
+#include "obstacles.h"   // Map building
+#include "EnemyTank.h"   // Enemy tanks and the shared enemy query
+#include "collision.h"   // Collision layers
+#include "gameSim.h"     // The game's simulation, for the pass through its update and collision phase
+#include <vector>        // Standard vector container
+#include <map>           // Standard map container
+#include <random>        // Standard random number generation
+#include <chrono>        // Standard clock for the timings
+#include <iostream>      // Standard input/output stream
+#include <cmath>         // Standard math functions
+
+using namespace std;  // Use the standard namespace
+
+// Define an obstacle of the reference world, one 30x30 rectangle per solid tile like the old obstacle list
+struct ReferenceTile {
+    TileType type;   // Type of the tile
+    int column;      // Position of the tile in the tile map
+    int row;
+    Rectangle rect;  // World rectangle of the tile
+};
+
+// Define the time spent by both paths on one kind of query
+struct QueryTiming {
+    const char* name;       // Name of the query
+    long long count = 0;    // Number of queries run
+    double referenceMs = 0; // Time spent in the plain loops
+    double fastMs = 0;      // Time spent in the fast path
+};
+
+// Function to get the milliseconds between two clock readings
+double elapsedMs(chrono::steady_clock::time_point start, chrono::steady_clock::time_point end) {
+    return chrono::duration<double, milli>(end - start).count();
+}
+
+// Function to add the 30x30 obstacles of one map cell to the reference list, from the columns and rows of the cell they cover
+void pushReferenceBlock(vector<ReferenceTile>& referenceTiles, TileType type, float blockX, float blockY, int firstColumn, int lastColumn, int firstRow, int lastRow) {
+    float tileSpacer = 30.0f;  // Spacing between tiles
+    for (int row = firstRow; row <= lastRow; row++) {
+        for (int column = firstColumn; column <= lastColumn; column++) {
+            Rectangle rect = { blockX + tileSpacer * column, blockY + tileSpacer * row, tileSpacer, tileSpacer };
+            referenceTiles.push_back({ type, (int)(rect.x / tileSpacer), (int)(rect.y / tileSpacer), rect });
+        }
+    }
+}
+
+// Function to build the reference obstacle list straight from the obstacle map, the way the old obstacle list was built
+void buildReferenceWorld(vector<ReferenceTile>& referenceTiles) {
+    referenceTiles.clear();
+    float tempWidth = 0;  // Position of the current map cell
+    float tempHeight = 0;
+
+    for (int i = 0; i < 454; ++i) {
+        for (int j = 0; j < 13; ++j) {
+            switch (tempObstacleMap[i][j]) {  // Spawn points are not obstacles
+            case BRICK_BLOCK: pushReferenceBlock(referenceTiles, TILE_BRICK, tempWidth, tempHeight, 0, 3, 0, 3); break;
+            case BARRIER_BLOCK: pushReferenceBlock(referenceTiles, TILE_BARRIER, tempWidth, tempHeight, 0, 3, 0, 3); break;
+            case TREE_BLOCK: pushReferenceBlock(referenceTiles, TILE_TREE, tempWidth, tempHeight, 0, 3, 0, 3); break;
+            case WATER: pushReferenceBlock(referenceTiles, TILE_WATER, tempWidth, tempHeight, 0, 3, 0, 3); break;
+            case HALF_LOWER_BARRIER_BLOCK: pushReferenceBlock(referenceTiles, TILE_BARRIER, tempWidth, tempHeight, 0, 3, 2, 3); break;
+            case HALF_UPPER_BARRIER_BLOCK: pushReferenceBlock(referenceTiles, TILE_BARRIER, tempWidth, tempHeight, 0, 3, 0, 1); break;
+            case HALF_LEFT_BARRIER_BLOCK: pushReferenceBlock(referenceTiles, TILE_BARRIER, tempWidth, tempHeight, 0, 1, 0, 3); break;
+            case HALF_RIGHT_BARRIER_BLOCK: pushReferenceBlock(referenceTiles, TILE_BARRIER, tempWidth, tempHeight, 2, 3, 0, 3); break;
+            case HALF_LOWER_BRICK_BLOCK: pushReferenceBlock(referenceTiles, TILE_BRICK, tempWidth, tempHeight, 0, 3, 2, 3); break;
+            case HALF_UPPER_BRICK_BLOCK: pushReferenceBlock(referenceTiles, TILE_BRICK, tempWidth, tempHeight, 0, 3, 0, 1); break;
+            case HALF_LEFT_BRICK_BLOCK: pushReferenceBlock(referenceTiles, TILE_BRICK, tempWidth, tempHeight, 0, 1, 0, 3); break;
+            case HALF_RIGHT_BRICK_BLOCK: pushReferenceBlock(referenceTiles, TILE_BRICK, tempWidth, tempHeight, 2, 3, 0, 3); break;
+            default: break;
+            }
+            tempWidth += 30.0f * 4;  // Move to the next map cell horizontally
+        }
+        tempHeight += 30.0f * 4;  // Move to the next row of map cells
+        tempWidth = 0;
+    }
+}
+
+// Function to remove a destroyed brick from the reference list, the way the old obstacle list dropped it
+void eraseReferenceTile(vector<ReferenceTile>& referenceTiles, int column, int row) {
+    for (size_t i = 0; i < referenceTiles.size(); i++) {
+        if (referenceTiles[i].column == column && referenceTiles[i].row == row) {
+            referenceTiles.erase(referenceTiles.begin() + i);
+            return;
+        }
+    }
+}
+
+// Function to find the reference tile at a tile position, or nullptr
+const ReferenceTile* findReferenceTile(const vector<ReferenceTile>& referenceTiles, int column, int row) {
+    for (const auto& tile : referenceTiles) {
+        if (tile.column == column && tile.row == row) return &tile;
+    }
+    return nullptr;
+}
+
+// Function to check whether a rectangle overlaps any reference tile with the flag (linear scan)
+bool referenceOverlaps(const vector<ReferenceTile>& referenceTiles, const Rectangle& rect, TileFlag flag) {
+    for (const auto& tile : referenceTiles) {
+        if ((tileFlags[tile.type] & flag) && CheckCollisionRecs(rect, tile.rect)) return true;
+    }
+    return false;
+}
+
+// Function to get the distance at which a rectangle moving along a direction starts to overlap a tile, or INFINITY
+double referenceEntryDistance(const Rectangle& rect, Vector2 direction, const Rectangle& tile) {
+    double enter = -INFINITY, leave = INFINITY;  // Distances between which the rectangles overlap
+    double starts[2] = { rect.x, rect.y }, sizes[2] = { rect.width, rect.height };
+    double tileStarts[2] = { tile.x, tile.y }, tileSizes[2] = { tile.width, tile.height };
+    double directions[2] = { direction.x, direction.y };
+
+    for (int axis = 0; axis < 2; axis++) {  // Overlap interval along each axis (open, touching edges do not count)
+        double low = tileStarts[axis] - (starts[axis] + sizes[axis]);  // Offset at which the rectangle reaches the tile
+        double high = tileStarts[axis] + tileSizes[axis] - starts[axis];  // Offset at which it has passed the tile
+        if (directions[axis] == 0) {
+            if (low >= 0 || high <= 0) return INFINITY;  // Never overlaps along this axis
+            continue;
+        }
+        double first = low / directions[axis], second = high / directions[axis];
+        enter = fmax(enter, fmin(first, second));
+        leave = fmin(leave, fmax(first, second));
+    }
+
+    if (enter >= leave || leave <= 0) return INFINITY;  // No overlap ahead
+    return fmax(enter, 0.0);  // Already overlapping at the start
+}
+
+// Function to find the first reference tile with the flag hit by a moving rectangle (linear scan)
+double referenceSweep(const vector<ReferenceTile>& referenceTiles, const Rectangle& rect, Vector2 direction, float maxDistance, TileFlag flag) {
+    double nearest = INFINITY;
+    for (const auto& tile : referenceTiles) {
+        if (!(tileFlags[tile.type] & flag)) continue;
+        double distance = referenceEntryDistance(rect, direction, tile.rect);
+        if (distance <= maxDistance && distance < nearest) nearest = distance;
+    }
+    return nearest;
+}
+
+// Function to find the first enemy tank overlapping a rectangle (linear scan, the loop the game used before the grid)
+int referenceEnemy(const EnemyTanks& allEnemyTanks, const Rectangle& rect, const Rectangle* ignoreRect) {
+    for (int i = 0; i < (int)allEnemyTanks.size(); i++) {
+        if (allEnemyTanks.destroyed[i]) continue;
+        if (ignoreRect && !areRectanglesDifferent(*ignoreRect, allEnemyTanks.posAndRects[i])) continue;
+        if (CheckCollisionRecs(rect, allEnemyTanks.posAndRects[i])) return i;
+    }
+    return -1;
+}
+
+// Function to print a rectangle
+void printRect(const Rectangle& rect) {
+    cout << "{" << rect.x << ", " << rect.y << ", " << rect.width << ", " << rect.height << "}";
+}
+
+// Function to scatter enemy tanks around a window of the map, a crowd is big enough for the bucket grid
+void scatterEnemyTanks(mt19937& gen, EnemyTanks& allEnemyTanks, float windowX, float windowY, bool crowd) {
+    uniform_real_distribution<float> unit(0.0f, 1.0f);
+    allEnemyTanks.clear();
+    int tankCount = crowd ? enemyGridThreshold + (int)(unit(gen) * 400) : 5 + (int)(unit(gen) * 40);
+    float spread = crowd ? 1500.0f : 550.0f;  // Side of the square the tanks are scattered in
+    for (int i = 0; i < tankCount; i++) {
+        Vector2 position = { windowX + 275.0f + (unit(gen) - 0.5f) * spread, windowY + 275.0f + (unit(gen) - 0.5f) * spread };
+        int row = allEnemyTanks.add(EnemyTank(BASIC, { 50, 53 }, position, 1));
+        allEnemyTanks.destroyed[row] = unit(gen) < 0.1f;
+    }
+}
+
+// Define the pass that runs shells and player tank moves through the game's own update and collision phase
+// It has its own simulation and its own reference list, the bricks its shells destroy are removed from both.
+struct GamePathCheck {
+    GameSim sim;                           // The game's simulation, run without a window
+    GameStatus gameStatus;
+    vector<ReferenceTile> referenceTiles;  // The game's world as a plain obstacle list
+    float deltaTime = 1.0f / 60.0f;        // One fixed tick
+    float playerStep = 0.0f;               // Distance the player tank moves in a tick, measured at its first move
+    long long shells = 0;                  // Shells followed to the end of their path
+    long long tileHits = 0;                // Shells that exploded on a tile
+    long long enemyHits = 0;               // Enemy tanks destroyed by the collision phase
+    long long moves = 0;                   // Player tank moves checked
+
+    GamePathCheck() {
+        sim.initialise(0.0f, 0.0f, 13 * 4 * 30, 455 * 4 * 30, { 0, 0 });  // World size as the map builds it, the player tank is placed by each move check
+        sim.shellWidth = sim.shellHeight = 10;  // The shells get the size of the queries above
+        buildReferenceWorld(referenceTiles);
+    }
+
+    // Check how a shell ended against the reference, hitTile tells whether the collision phase exploded it on a tile
+    bool checkShellOutcome(const TankShell& shell, bool hitTile) {
+        Rectangle startRect = { shell.StartPosition.x - 5, shell.StartPosition.y - 5, 10, 10 };
+        double expected = referenceSweep(referenceTiles, startRect, shell.direction, shell.maxDistance, TILE_BLOCKS_SHELLS);
+        shells++;
+
+        bool same = hitTile == (expected != INFINITY);
+        if (same && hitTile) {  // The tile it exploded on must be the first one on its path
+            const ReferenceTile* tile = findReferenceTile(referenceTiles, shell.impactColumn, shell.impactRow);
+            same = tile && (tileFlags[tile->type] & TILE_BLOCKS_SHELLS)
+                && fabs(referenceEntryDistance(startRect, shell.direction, tile->rect) - expected) < 0.05
+                && fabs(shell.impactDistance - expected) < 0.05;  // Later shells find their impact again from where they are
+            if (same && tile->type == TILE_BRICK) {
+                same = !sim.tileMap.blocksShells(shell.impactColumn, shell.impactRow);  // The collision phase destroyed it
+                eraseReferenceTile(referenceTiles, shell.impactColumn, shell.impactRow);
+            }
+            tileHits++;
+        }
+
+        if (!same) {
+            cout << "Divergence in the game pass: shell from (" << shell.StartPosition.x << ", " << shell.StartPosition.y << ") towards ("
+                << shell.direction.x << ", " << shell.direction.y << ") up to " << shell.maxDistance << ", reference " << expected
+                << ", game " << (hitTile ? shell.impactDistance : INFINITY) << " at tile " << shell.impactColumn << ", " << shell.impactRow << endl;
+        }
+        return same;
+    }
+
+    // Fire one or two shells along the same line and run the game's ticks until they are gone
+    // The second shell follows a tick later, so a brick destroyed by the first has to drop out of its path.
+    bool shellVolley(mt19937& gen, float windowX, float windowY) {
+        uniform_real_distribution<float> unit(0.0f, 1.0f);
+        sim.allEnemyTanks.clear();  // Only the tiles this time
+        sim.playerTankShells.clear();
+
+        Vector2 start = { windowX + unit(gen) * 550, windowY + unit(gen) * 550 };
+        float angle = unit(gen) < 0.5f ? (int)(unit(gen) * 4) * 90.0f : unit(gen) * 360.0f;  // Half the shots straight
+        Vector2 direction = { cosf((angle - 90) * DEG2RAD), sinf((angle - 90) * DEG2RAD) };  // As the shell works it out
+        float range = 50 + unit(gen) * 1000;
+        int count = unit(gen) < 0.5f ? 1 : 2;
+
+        int fired = 0;
+        for (int tick = 0; tick < 200 && (fired < count || !sim.playerTankShells.empty()); tick++) {
+            if (fired < count) {
+                float shellRange = range + fired;  // The shells are told apart by their range
+                sim.playerTankShells.emplace_back(start, angle, Vector2{ start.x + direction.x * shellRange, start.y + direction.y * shellRange }, PLAYERTANK);
+                fired++;
+            }
+
+            vector<TankShell> before = sim.playerTankShells;
+            sim.UpdateShells(deltaTime);  // Drops the shells that reached their range without a hit
+            for (const auto& shell : before) {
+                if (!hasShell(shell) && !checkShellOutcome(shell, false)) return false;
+            }
+
+            vector<TankShell> arrived;  // Shells at their impact point, the collision phase explodes them
+            for (const auto& shell : sim.playerTankShells) {
+                if (shell.reachedImpact()) arrived.push_back(shell);
+            }
+            sim.checkCollisions();
+            for (const auto& shell : arrived) {
+                if (!hasShell(shell) && !checkShellOutcome(shell, true)) return false;
+            }
+        }
+
+        if (!sim.playerTankShells.empty()) {  // Every shell reaches its range or a tile well within the ticks
+            const TankShell& shell = sim.playerTankShells.front();
+            cout << "Divergence in the game pass: shell from (" << shell.StartPosition.x << ", " << shell.StartPosition.y << ") towards ("
+                << shell.direction.x << ", " << shell.direction.y << ") still flying after " << shell.distanceTraveled << endl;
+            return false;
+        }
+        return true;
+    }
+
+    // Check whether the game still has a shell, found by its range
+    bool hasShell(const TankShell& shell) const {
+        for (const auto& other : sim.playerTankShells) {
+            if (other.maxDistance == shell.maxDistance) return true;
+        }
+        return false;
+    }
+
+    // Drop shells on and around the enemy tanks and run one collision phase
+    bool shellsIntoTanks(mt19937& gen, const EnemyTanks& allEnemyTanks, float windowX, float windowY) {
+        uniform_real_distribution<float> unit(0.0f, 1.0f);
+        sim.allEnemyTanks = allEnemyTanks;
+        sim.playerTankShells.clear();
+        sim.events.clear();
+
+        vector<unsigned char> destroyed = allEnemyTanks.destroyed;  // Tanks destroyed by the reference's shells
+        vector<Vector2> expected;  // Centres of the destroyed tanks, in the order the shells hit them
+        int count = 1 + (int)(unit(gen) * 8);
+        for (int k = 0; k < count; k++) {
+            Vector2 position = { windowX + unit(gen) * 550, windowY + unit(gen) * 550 };
+            if (allEnemyTanks.size() > 0 && unit(gen) < 0.5f) {  // Right on a tank now and then, two shells may pick the same one
+                Vector2 centre = allEnemyTanks.centre((size_t)(unit(gen) * allEnemyTanks.size()) % allEnemyTanks.size());
+                position = { centre.x + (unit(gen) - 0.5f) * 60, centre.y + (unit(gen) - 0.5f) * 60 };
+            }
+
+            TankShell shell(position, 0.0f, { position.x, position.y - 1000 }, PLAYERTANK);
+            shell.impactDirty = false;  // No tile on its path, only the tanks are tested
+            sim.playerTankShells.push_back(shell);
+
+            // The contacts are all found before any is applied, a shell whose tank was already hit this phase flies on
+            Rectangle shellRect = { position.x - 5, position.y - 5, 10, 10 };
+            int hit = referenceEnemy(allEnemyTanks, shellRect, nullptr);
+            if (hit >= 0 && !destroyed[hit]) {
+                destroyed[hit] = 1;
+                expected.push_back(allEnemyTanks.centre(hit));
+            }
+        }
+
+        sim.checkCollisions();
+
+        vector<Vector2> actual;
+        for (const auto& event : sim.events) {
+            if (event.type == SIM_EVENT_ENEMY_DESTROYED) actual.push_back(event.position);
+        }
+        bool same = actual.size() == expected.size() && sim.playerTankShells.size() == count - expected.size();
+        for (size_t i = 0; same && i < actual.size(); i++) {
+            same = actual[i].x == expected[i].x && actual[i].y == expected[i].y;
+        }
+        enemyHits += actual.size();
+
+        if (!same) {
+            cout << "Divergence in the game pass: " << count << " shells into " << allEnemyTanks.size() << " tanks, reference destroyed "
+                << expected.size() << ", game " << actual.size() << " with " << sim.playerTankShells.size() << " shells left" << endl;
+        }
+        return same;
+    }
+
+    // Drive the player tank through its own update towards the tiles and enemy tanks
+    bool playerMoves(mt19937& gen, const EnemyTanks& allEnemyTanks, float windowX, float windowY) {
+        uniform_real_distribution<float> unit(0.0f, 1.0f);
+        sim.allEnemyTanks = allEnemyTanks;
+        rebuildEnemyGrid(sim.enemyGrid, sim.allEnemyTanks);
+        sim.playerTank.initialise(windowX + 100 + unit(gen) * 350, windowY + 100 + unit(gen) * 350);  // Ten ticks never reach the canvas edge
+
+        const bool keys[8][4] = {  // Up, down, left and right for each of the eight directions
+            { 1, 0, 0, 0 }, { 0, 1, 0, 0 }, { 0, 0, 1, 0 }, { 0, 0, 0, 1 },
+            { 1, 0, 1, 0 }, { 1, 0, 0, 1 }, { 0, 1, 1, 0 }, { 0, 1, 0, 1 }
+        };
+        int pick = (int)(unit(gen) * 8) % 8;
+        SimInput input;
+        input.up = keys[pick][0];
+        input.down = keys[pick][1];
+        input.left = keys[pick][2];
+        input.right = keys[pick][3];
+
+        for (int tick = 0; tick < 10; tick++) {
+            Vector2 before = sim.playerTank.position;
+            sim.playerTank.Update(deltaTime, input, sim.events, gameStatus, sim.playerTankShells, sim.canvasWidth, sim.canvasHeight, sim.tileMap, sim.allEnemyTanks, sim.enemyGrid);
+            Vector2 after = sim.playerTank.position;
+            bool moved = after.x != before.x || after.y != before.y;
+
+            if (moved && playerStep == 0.0f) playerStep = hypotf(after.x - before.x, after.y - before.y);
+            if (playerStep == 0.0f) continue;  // Where a blocked move was going is not known yet
+
+            float rotation = sim.playerTank.GetRotation();  // The tank turns before it moves
+            Vector2 potential = { before.x + playerStep * cosf((rotation - 90.0f) * DEG2RAD), before.y + playerStep * sinf((rotation - 90.0f) * DEG2RAD) };
+            int width = (int)sim.playerTank.tankRect.width, height = (int)sim.playerTank.tankRect.height;
+            Rectangle box = { potential.x - width / 2, potential.y - height / 2, (float)width, (float)height };  // Halves rounded down, like the tank's own box
+            bool blocked = referenceOverlaps(referenceTiles, box, TILE_BLOCKS_TANKS) || referenceEnemy(sim.allEnemyTanks, box, nullptr) >= 0;
+            moves++;
+
+            if (blocked == moved) {
+                cout << "Divergence in the game pass: player tank at (" << before.x << ", " << before.y << ") moving into ";
+                printRect(box);
+                cout << ", reference " << (blocked ? "blocked" : "free") << ", game " << (moved ? "moved" : "stopped") << endl;
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+// Function to run the game pass, returns 0 if the game agreed with the reference on every shell and move
+int runGamePathCheck(mt19937& gen, int rounds) {
+    uniform_real_distribution<float> unit(0.0f, 1.0f);
+    GamePathCheck check;
+    EnemyTanks allEnemyTanks;
+
+    for (int round = 0; round < rounds; round++) {
+        float windowX = unit(gen) * (check.sim.canvasWidth - 600.0f);
+        float windowY = unit(gen) * (check.sim.canvasHeight - 600.0f);
+        scatterEnemyTanks(gen, allEnemyTanks, windowX, windowY, round % 4 == 3);
+
+        for (int query = 0; query < 25; query++) {
+            if (!check.shellVolley(gen, windowX, windowY)) return 1;
+            if (!check.shellsIntoTanks(gen, allEnemyTanks, windowX, windowY)) return 1;
+            if (!check.playerMoves(gen, allEnemyTanks, windowX, windowY)) return 1;
+        }
+    }
+
+    cout << "Game pass agreed: " << check.shells << " shells (" << check.tileHits << " on tiles), " << check.enemyHits
+        << " enemy tanks destroyed, " << check.moves << " player tank moves" << endl;
+    return 0;
+}
+
+// Function to run the self check, returns 0 if both paths agreed on every query
+int runCollisionSelfCheck(unsigned seed = 20240601, int rounds = 40) {
+    cout << "Collision self check, seed " << seed << endl;
+
+    mt19937 gen(seed);  // Every random choice comes from this generator, so a seed reproduces a run
+    uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    TileMap tileMap;  // The world as the game builds it
+    map<int, vector<Rectangle>> levelSpawnPoints;
+    initialiseObstacles(tileMap, levelSpawnPoints);
+
+    vector<ReferenceTile> referenceTiles;  // The same world as a plain obstacle list
+    buildReferenceWorld(referenceTiles);
+
+    float canvasWidth = tileMap.columns * TileMap::tileSize;  // World size
+    float canvasHeight = tileMap.rows * TileMap::tileSize;
+
+    EntityGrid enemyGrid;  // Bucket grid as the game uses it
+    enemyGrid.resize((int)canvasWidth, (int)canvasHeight);
+    EnemyTanks allEnemyTanks;
+    vector<int> nearbyTanks;
+
+    QueryTiming tileTiming{ "tank vs tiles" }, sweepTiming{ "shell path" }, enemyTiming{ "vs enemy tanks" }, crowdTiming{ "vs enemy crowd" };
+    long long destroyedBricks = 0;
+    vector<Rectangle> clearedTiles;  // Tiles removed by the last publish
+
+    for (int round = 0; round < rounds; round++) {
+        // Pick a window of the map, the queries of this round all land in it so they run into things
+        float windowX = unit(gen) * (canvasWidth - 600.0f);
+        float windowY = unit(gen) * (canvasHeight - 600.0f);
+
+        // Scatter some enemy tanks in the window, every fourth round a crowd around it big enough for the bucket grid
+        bool crowd = round % 4 == 3;
+        scatterEnemyTanks(gen, allEnemyTanks, windowX, windowY, crowd);
+        rebuildEnemyGrid(enemyGrid, allEnemyTanks);
+        QueryTiming& tankTiming = crowd ? crowdTiming : enemyTiming;
+
+        for (int query = 0; query < 500; query++) {
+            // Tank moving into a rectangle (tiles)
+            Rectangle tankRect = { windowX + unit(gen) * 550, windowY + unit(gen) * 550, 50, 53 };
+            if (unit(gen) < 0.3f) {  // Snap to the tile edges now and then, touching edges are the easy ones to get wrong
+                tankRect.x = roundf(tankRect.x / TileMap::tileSize) * TileMap::tileSize;
+                tankRect.y = roundf(tankRect.y / TileMap::tileSize) * TileMap::tileSize;
+            }
+            CollisionLayer layer = unit(gen) < 0.5f ? LAYER_PLAYER : LAYER_PLAYER_SHELL;
+
+            auto start = chrono::steady_clock::now();
+            bool expected = referenceOverlaps(referenceTiles, tankRect, tileFlagFor(layer));
+            auto middle = chrono::steady_clock::now();
+            bool actual = tilesBlockMove(tileMap, tankRect, layer);
+            auto end = chrono::steady_clock::now();
+            tileTiming.count++;
+            tileTiming.referenceMs += elapsedMs(start, middle);
+            tileTiming.fastMs += elapsedMs(middle, end);
+
+            if (expected != actual) {
+                cout << "Divergence in round " << round << ", query " << query << ": tiles under ";
+                printRect(tankRect);
+                cout << " for layer " << (int)layer << ", reference " << expected << ", fast " << actual << endl;
+                return 1;
+            }
+
+            // Shell travelling along a path
+            Rectangle shellRect = { windowX + unit(gen) * 550, windowY + unit(gen) * 550, 10, 10 };
+            float angle = unit(gen) < 0.5f ? (int)(unit(gen) * 4) * PI / 2 : unit(gen) * 2 * PI;  // Half the shots straight, like the game's usual aim
+            Vector2 direction = { cosf(angle), sinf(angle) };
+            if (fabsf(direction.x) < 1e-6f) direction.x = 0;
+            if (fabsf(direction.y) < 1e-6f) direction.y = 0;
+            float maxDistance = 50 + unit(gen) * 1000;
+
+            float hitDistance = 0;
+            int hitColumn = -1, hitRow = -1;
+            start = chrono::steady_clock::now();
+            double expectedDistance = referenceSweep(referenceTiles, shellRect, direction, maxDistance, TILE_BLOCKS_SHELLS);
+            middle = chrono::steady_clock::now();
+            bool hit = tileMap.sweep(shellRect, direction, maxDistance, TILE_BLOCKS_SHELLS, hitDistance, hitColumn, hitRow);
+            end = chrono::steady_clock::now();
+            sweepTiming.count++;
+            sweepTiming.referenceMs += elapsedMs(start, middle);
+            sweepTiming.fastMs += elapsedMs(middle, end);
+
+            bool sameHit = hit == (expectedDistance != INFINITY);
+            if (sameHit && hit) {
+                double tileDistance = referenceEntryDistance(shellRect, direction, tileMap.tileRect(hitColumn, hitRow));  // The reported tile must be hit at that distance
+                sameHit = fabs(hitDistance - expectedDistance) < 1e-3 && fabs(tileDistance - expectedDistance) < 1e-3 && tileMap.blocksShells(hitColumn, hitRow);
+            }
+            if (!sameHit) {
+                cout << "Divergence in round " << round << ", query " << query << ": shell ";
+                printRect(shellRect);
+                cout << " towards (" << direction.x << ", " << direction.y << ") up to " << maxDistance
+                    << ", reference " << expectedDistance << ", fast " << (hit ? hitDistance : INFINITY)
+                    << " at tile " << hitColumn << ", " << hitRow << endl;
+                return 1;
+            }
+
+            // Tank or shell against the enemy tanks
+            int mover = (int)(unit(gen) * allEnemyTanks.size());
+            bool moving = unit(gen) < 0.5f;  // An enemy tank moving leaves itself out, a shell does not
+            Rectangle queryRect = moving ? allEnemyTanks.posAndRects[mover] : shellRect;
+            if (moving) {
+                queryRect.x += (unit(gen) - 0.5f) * 10;
+                queryRect.y += (unit(gen) - 0.5f) * 10;
+            }
+            const Rectangle* ignoreRect = moving ? &allEnemyTanks.posAndRects[mover] : nullptr;
+
+            start = chrono::steady_clock::now();
+            int expectedTank = referenceEnemy(allEnemyTanks, queryRect, ignoreRect);
+            middle = chrono::steady_clock::now();
+            int actualTank = findOverlappingEnemy(queryRect, queryRect, allEnemyTanks, ignoreRect, enemyGrid, nearbyTanks);
+            end = chrono::steady_clock::now();
+            tankTiming.count++;
+            tankTiming.referenceMs += elapsedMs(start, middle);
+            tankTiming.fastMs += elapsedMs(middle, end);
+
+            if (expectedTank != actualTank) {
+                cout << "Divergence in round " << round << ", query " << query << ": enemy tanks under ";
+                printRect(queryRect);
+                cout << ", reference " << expectedTank << ", fast " << actualTank << endl;
+                return 1;
+            }
+
+            // Destroy a brick now and then, both worlds must keep agreeing afterwards
+            if (unit(gen) < 0.2f) {
+                int column = (int)((windowX + unit(gen) * 600) / TileMap::tileSize);  // A tile in the window
+                int row = (int)((windowY + unit(gen) * 600) / TileMap::tileSize);
+                if (tileMap.inBounds(column, row) && tileMap.isDestructible(column, row)) {
+                    tileMap.queueClear(column, row);
+                    tileMap.publish(clearedTiles);  // Published straight away, the next query must see it
+                    eraseReferenceTile(referenceTiles, column, row);
+                    destroyedBricks++;
+                }
+            }
+        }
+    }
+
+    cout << "No divergence, " << destroyedBricks << " bricks destroyed on the way" << endl;
+    for (const QueryTiming* timing : { &tileTiming, &sweepTiming, &enemyTiming, &crowdTiming }) {
+        cout << "  " << timing->name << ": " << timing->count << " queries, reference " << timing->referenceMs << " ms, fast "
+            << timing->fastMs << " ms, speedup " << (timing->fastMs > 0 ? timing->referenceMs / timing->fastMs : 0) << "x" << endl;
+    }
+    return runGamePathCheck(gen, rounds);  // Then the same kinds of queries through the game itself
+}
+
+// Seeds the self check runs with, a rounding slip often shows up on one seed only
+const unsigned selfCheckSeeds[] = { 20240601, 1, 2, 3, 4 };
+
+// Function to run the self check with every seed, returns 0 if all of them agreed
+int runCollisionSelfChecks() {
+    for (unsigned seed : selfCheckSeeds) {
+        if (runCollisionSelfCheck(seed) != 0) return 1;  // The divergence printed is reproduced by its seed
+    }
+    return 0;
+}
+
+#endif
@@ -0,0 +1,82 @@
+#ifndef DYNAMIC_RESOLUTION_H
+#define DYNAMIC_RESOLUTION_H
+
+// Include necessary libraries and headers
+#include "raylib.h"  // Raylib library for render textures and drawing
+
+// Define the DynamicResolution class
+// The world is drawn into an offscreen texture at a fraction of the screen size and stretched onto the screen.
+// The fraction is set every frame by the quality governor, each step keeps its own texture so a change costs nothing.
+class DynamicResolution {
+private:
+    static const int stepCount = 5;  // Number of resolution steps
+    float scales[stepCount] = { 0.5f, 0.625f, 0.75f, 0.875f, 1.0f };  // Fraction of the screen size at each step
+    RenderTexture2D targets[stepCount] = {};  // Offscreen texture of each step, created the first time the step is used
+
+    int step = stepCount - 1;  // Current step (full resolution at the start)
+    int screenWidth = 0;       // Size of the screen the world is stretched onto
+    int screenHeight = 0;
+    bool enabled = false;      // Whether the offscreen textures work (the world is drawn straight to the screen otherwise)
+    bool active = false;       // Whether the world is being drawn into the offscreen texture
+
+    // Get the texture of the current step, creating it if needed
+    RenderTexture2D& currentTarget() {
+        RenderTexture2D& target = targets[step];
+        if (target.id == 0) {
+            target = LoadRenderTexture((int)(screenWidth * scales[step]), (int)(screenHeight * scales[step]));
+            SetTextureFilter(target.texture, TEXTURE_FILTER_BILINEAR);  // Smooth when stretched
+        }
+        return target;
+    }
+
+public:
+    DynamicResolution() {}  // Default constructor
+
+    // Set the screen size, returns false if offscreen textures cannot be created
+    bool initialise(int widthOfScreen, int heightOfScreen) {
+        screenWidth = widthOfScreen;
+        screenHeight = heightOfScreen;
+        enabled = currentTarget().id != 0;
+        return enabled;
+    }
+
+    // Use the largest step that is not above the given fraction of the screen size
+    void setScale(float scale) {
+        step = 0;
+        for (int i = 0; i < stepCount; i++) {
+            if (scales[i] <= scale + 0.001f) step = i;
+        }
+    }
+
+    // Get the fraction of the screen size the world is drawn at
+    float getScale() const {
+        return enabled ? scales[step] : 1.0f;
+    }
+
+    // Start drawing the world, the camera is scaled to the offscreen texture (call it instead of BeginMode2D)
+    void begin(const Camera2D& camera, Color background) {
+        Camera2D scaledCamera = camera;
+        active = enabled && currentTarget().id != 0;
+        if (active) {
+            scaledCamera.offset = { camera.offset.x * scales[step], camera.offset.y * scales[step] };
+            scaledCamera.zoom = camera.zoom * scales[step];  // Same part of the world on fewer pixels
+            BeginTextureMode(currentTarget());
+            ClearBackground(background);
+        }
+        BeginMode2D(scaledCamera);
+    }
+
+    // Stop drawing the world and stretch it onto the screen (call it instead of EndMode2D)
+    void end() {
+        EndMode2D();
+        if (!active) return;
+
+        EndTextureMode();
+        const Texture2D& texture = currentTarget().texture;
+        Rectangle source = { 0.0f, 0.0f, (float)texture.width, -(float)texture.height };  // Render textures are stored upside down
+        DrawTexturePro(texture, source, { 0.0f, 0.0f, (float)screenWidth, (float)screenHeight }, { 0.0f, 0.0f }, 0.0f, WHITE);
+        active = false;
+    }
+};
+
+#endif
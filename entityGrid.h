@@ -0,0 +1,110 @@
+#ifndef ENTITY_GRID_H
+#define ENTITY_GRID_H
+
+// Include necessary libraries and headers
+#include "simTypes.h"  // Rectangle type, from raylib unless built headless
+#include <vector>    // Standard vector container
+#include <cmath>     // Standard math functions (floor, ceil)
+
+using namespace std;  // Use the standard namespace
+
+// Define the EntityGrid class
+// A bucket grid for moving objects (tanks). It is cleared and refilled every frame; each bucket
+// holds the indices of the entities whose rectangle overlaps it, so a query only looks at nearby entities.
+class EntityGrid {
+private:
+    float cellSize = 120.0f;  // Size of each bucket (one obstacle map cell, larger than a tank)
+    int columns = 0;          // Number of buckets across the canvas
+    int rows = 0;             // Number of buckets down the canvas
+
+    vector<vector<int>> cells;  // Entity indices stored in each bucket
+    vector<int> usedCells;      // Buckets that received an entry since the last clear
+    int entities = 0;           // Entities inserted since the last clear
+
+    vector<int> visitStamp;  // Last query that returned each entity (used to skip duplicates)
+    int currentStamp = 0;    // Identifier of the current query
+
+    // Convert a rectangle into the range of buckets it overlaps, returns false if the grid has no buckets
+    // The border buckets reach past the canvas, so a rectangle sticking out of it still meets the ones beside it.
+    bool cellRange(const Rectangle& area, int& firstColumn, int& lastColumn, int& firstRow, int& lastRow) const {
+        firstColumn = clampCell((int)floor(area.x / cellSize), columns);  // Leftmost bucket touched by the rectangle
+        firstRow = clampCell((int)floor(area.y / cellSize), rows);  // Topmost bucket touched by the rectangle
+        lastColumn = clampCell((int)ceil((area.x + area.width) / cellSize) - 1, columns);  // Rightmost bucket
+        lastRow = clampCell((int)ceil((area.y + area.height) / cellSize) - 1, rows);  // Bottommost bucket
+
+        return columns > 0 && rows > 0;
+    }
+
+    // Clamp a bucket coordinate to the grid
+    static int clampCell(int cell, int count) {
+        if (cell > count - 1) cell = count - 1;
+        if (cell < 0) cell = 0;
+        return cell;
+    }
+
+public:
+    EntityGrid() {}  // Default constructor
+
+    // Allocate the buckets for a canvas of the given size
+    void resize(int canvasWidth, int canvasHeight) {
+        columns = (int)ceil(canvasWidth / cellSize);  // Number of buckets across the canvas
+        rows = (int)ceil(canvasHeight / cellSize);  // Number of buckets down the canvas
+        cells.assign((size_t)columns * rows, vector<int>());  // Empty buckets
+        usedCells.clear();
+        entities = 0;
+    }
+
+    // Remove every entity (only the buckets that were used are touched)
+    void clear() {
+        for (int cell : usedCells) {
+            cells[cell].clear();  // Keeps the bucket's memory for the next frame
+        }
+        usedCells.clear();
+        entities = 0;
+    }
+
+    // Get the number of entities inserted since the last clear
+    int size() const {
+        return entities;
+    }
+
+    // Add an entity to the buckets its rectangle overlaps
+    void insert(int index, const Rectangle& rect) {
+        if (index >= (int)visitStamp.size()) visitStamp.resize(index + 1, 0);  // Make room in the duplicate filter
+        entities++;
+
+        int firstColumn, lastColumn, firstRow, lastRow;
+        if (!cellRange(rect, firstColumn, lastColumn, firstRow, lastRow)) return;  // No buckets allocated
+
+        for (int row = firstRow; row <= lastRow; row++) {
+            for (int column = firstColumn; column <= lastColumn; column++) {
+                int cell = row * columns + column;
+                if (cells[cell].empty()) usedCells.push_back(cell);  // Remember the bucket so clear() can reset it
+                cells[cell].push_back(index);
+            }
+        }
+    }
+
+    // Collect the indices of the entities stored in the buckets overlapped by the area (each index once, in bucket order)
+    void query(const Rectangle& area, vector<int>& candidates) {
+        candidates.clear();  // Start with an empty candidate list
+
+        int firstColumn, lastColumn, firstRow, lastRow;
+        if (!cellRange(area, firstColumn, lastColumn, firstRow, lastRow)) return;  // No buckets allocated
+
+        currentStamp++;  // Start a new query
+
+        for (int row = firstRow; row <= lastRow; row++) {
+            for (int column = firstColumn; column <= lastColumn; column++) {
+                for (int index : cells[row * columns + column]) {
+                    if (visitStamp[index] != currentStamp) {  // Skip entities already returned by this query
+                        visitStamp[index] = currentStamp;
+                        candidates.push_back(index);
+                    }
+                }
+            }
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef FIXED_TIMESTEP_H
+#define FIXED_TIMESTEP_H
+
+// Include necessary libraries and headers
+#include <cmath>  // Standard math functions (fmodf)
+
+// Define the FixedTimestep class
+// The frame time is collected in an accumulator and handed out in ticks of the same length, so the simulation runs the
+// same at any frame rate. What is left over is the fraction of a tick the drawing is ahead of the last tick.
+class FixedTimestep {
+private:
+    float tickTime = 1.0f / 60.0f;  // Length of a tick in seconds
+    float accumulator = 0.0f;       // Frame time not handed out as ticks yet
+    int maxTicksPerFrame = 5;       // Ticks run in one frame at most, a long stall is dropped instead of caught up
+    int ticksThisFrame = 0;         // Ticks handed out since the last advance()
+
+public:
+    FixedTimestep() {}  // Default constructor
+
+    // Set the length of a tick
+    explicit FixedTimestep(float secondsPerTick) : tickTime(secondsPerTick) {}
+
+    // Add the time of the last frame
+    void advance(float frameTime) {
+        accumulator += frameTime;
+        ticksThisFrame = 0;
+    }
+
+    // Take one tick out of the accumulator, returns false when there is less than a tick left
+    bool step() {
+        if (accumulator < tickTime) return false;
+        if (ticksThisFrame >= maxTicksPerFrame) {  // Too far behind, keep only the fraction so drawing stays smooth
+            accumulator = fmodf(accumulator, tickTime);
+            return false;
+        }
+        accumulator -= tickTime;
+        ticksThisFrame++;
+        return true;
+    }
+
+    // Get how far the frame is between the last tick and the next one, 0 to 1
+    float alpha() const {
+        return accumulator / tickTime;
+    }
+
+    // Get the length of a tick
+    float getTickTime() const {
+        return tickTime;
+    }
+
+    // Forget the time collected so far (e.g. after a pause)
+    void reset() {
+        accumulator = 0.0f;
+        ticksThisFrame = 0;
+    }
+};
+
+#endif
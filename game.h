@@ -1,3 +1,6 @@
+#ifndef GAME_H
+#define GAME_H
+
 #include "raylib.h"  // Include the main Raylib library
 #include "PlayerTank.h"  // Include the PlayerTank class
 #include <string>  // Include the string library
@@ -6,58 +9,61 @@
 #include "EnemyTank.h"  // Include the EnemyTank class
 #include <map>  // Include the map library for key-value pairs
 #include <random>  // Include the random library for random number generation
-
-class gameShellExplosionAnimation {  // Class for the explosion animation of shells
-public:
-    Vector2 position;  // Position of the explosion
-    int currentFrame;  // Current frame of the animation
-
-    gameShellExplosionAnimation(Vector2 pos, int currentFrame = 0)  // Constructor to initialize the explosion
-        : position(pos), currentFrame(currentFrame) {
-    }
-};
+#include "staticLayerCache.h"  // Include the baked static layer
+#include "textureAtlas.h"  // Include the sprite atlas
+#include "waterShader.h"  // Include the water animation shader
+#include "renderQueue.h"  // Include the layered draw queue
+#include "dynamicResolution.h"  // Include the scaled world pass
+#include "qualityGovernor.h"  // Include the quality tiers
+#include "overviewMap.h"  // Include the zoomed out map pyramid
+#include "simRandom.h"  // Include the seeded random streams
+#include "inputLog.h"  // Include the input recorder and player
+#include "gameSim.h"  // Include the headless simulation
 
 class Game {  // Main game class
 private:
     Texture2D backgroundTexture;  // Texture for the background
 
-    Texture2D enemyTankBasic;  // Texture for the basic enemy tank
-
-    PlayerTank playerTank;  // Instance of the PlayerTank class
-
-    vector<Obstacle> obstacles;  // Vector to store obstacles
-    vector<Texture2D> waterTextures;  // Vector to store water animation textures
-    Texture2D treeTexture;  // Texture for trees
-    Texture2D barrierTexture;  // Texture for barriers
-    Texture2D brickTexture;  // Texture for bricks
+    TextureAtlas spriteAtlas;  // Every in-game sprite packed into one texture
+
+    Sprite enemyTankBasic;  // Sprite for the basic enemy tank
+
+    GameSim sim;  // Everything a tick changes, drawn and played from here
+    MergedTiles mergedTiles;  // Static tiles merged into rectangles for drawing
+    Rectangle visibleWorld = { 0 };  // Part of the world on screen this frame, every draw layer skips what lies outside
+    StaticLayerCache staticLayer;  // Water, barriers, spawn points and bricks baked into render textures, drawn under the tanks
+    bool staticLayerReady = false;  // Whether the bands on screen are baked this frame
+    RenderQueue renderQueue;  // World draws of the frame, issued layer by layer in endCamera2D
+    DynamicResolution worldResolution;  // Offscreen pass the world is drawn into, at the scale of the quality tier
+    QualityGovernor qualityGovernor;  // Picks the quality tier from the frame time
+    TextCache textCache;  // Laid out text shared by the world and the HUD
+    RenderQueue hudQueue;  // Screen space draws on top of the world, at native resolution
+    OverviewMap overviewMap;  // Small copies of the map drawn when zoomed out
+    float targetZoom = 1.0f;  // Zoom the camera moves towards (mouse wheel)
+    float minZoom = 0.02f;  // Furthest the camera zooms out (most of the map on screen)
+    float overviewZoom = 0.5f;  // Below this zoom the map is drawn from the overview instead of the baked bands
+    float impostorZoom = 0.35f;  // Below this zoom the tanks are drawn as markers
+    int maxImpostors = 256;  // Most tank markers drawn in a frame
+    bool overviewActive = false;  // Whether the overview is drawn this frame
+
+    float interpolation = 1.0f;  // How far the frame is between the last two ticks, moving things are drawn blended by it
+    SimInput input;  // Player input for the next tick, a left click is kept until a tick uses it so it is neither lost nor fired twice
+    InputRecorder inputRecorder;  // Writes the input of every tick when recording
+    InputPlayer inputPlayer;  // Feeds a recorded session back in place of the keyboard and mouse
+    Sprite waterStrip;  // Every frame of the water animation side by side
+    WaterShader waterShader;  // Animates the water baked into the static layer
+    int waterFrameCount = 16;  // Number of frames in the water strip
+    Texture2D treeTexture = { 0 };  // Texture for trees, repeats across a merged rectangle
+    Texture2D barrierTexture = { 0 };  // Texture for barriers, repeats across a merged rectangle
+    Sprite brickTexture;  // Sprite for bricks
 
     int currentWaterFrame = 0;  // Current frame of the water animation
-    float waterAnimationTimer = 0.0f;  // Timer for water animation
+    float waterAnimationTimer = 0.0f;  // Time into the water animation, wrapped after the last frame
     float waterFrameTime = 0.05f;  // Time between water animation frames
 
     Vector2 defaultTileWidthHeight = { 30, 30 };  // Default size of tiles
-    float TileSpacer = defaultTileWidthHeight.x;  // Spacing between tiles
-
-    float maxTimeBeforeNextWave = 60.0f;  // Maximum time before the next wave of enemies
-
-    int levelHeight = TileSpacer * 4 * 13;  // Height of each level
-    int currentLevel = 0;  // Current level
-
-    float levelData[35][3] = {  // Data for each level (number of enemies, elapsed time, max time)
-        { 3.0f, 0.0f, 60.0f }, { 3.0f, 0.0f, 60.0f }, { 3.0f, 0.0f, 60.0f }, { 3.0f, 0.0f, 60.0f },
-        { 3.0f, 0.0f, 60.0f }, { 3.0f, 0.0f, 60.0f }, { 3.0f, 0.0f, 60.0f }, { 3.0f, 0.0f, 60.0f },
-        { 3.0f, 0.0f, 60.0f }, { 3.0f, 0.0f, 60.0f }, { 3.0f, 0.0f, 60.0f }, { 3.0f, 0.0f, 60.0f },
-        { 3.0f, 0.0f, 60.0f }, { 3.0f, 0.0f, 60.0f }, { 3.0f, 0.0f, 60.0f }, { 3.0f, 0.0f, 60.0f },
-        { 3.0f, 0.0f, 60.0f }, { 3.0f, 0.0f, 60.0f }, { 3.0f, 0.0f, 60.0f }, { 3.0f, 0.0f, 60.0f },
-        { 3.0f, 0.0f, 60.0f }, { 3.0f, 0.0f, 60.0f }, { 3.0f, 0.0f, 60.0f }, { 3.0f, 0.0f, 60.0f },
-        { 3.0f, 0.0f, 60.0f }, { 3.0f, 0.0f, 60.0f }, { 3.0f, 0.0f, 60.0f }, { 3.0f, 0.0f, 60.0f },
-        { 3.0f, 0.0f, 60.0f }, { 3.0f, 0.0f, 60.0f }, { 3.0f, 0.0f, 60.0f }, { 3.0f, 0.0f, 60.0f },
-        { 3.0f, 0.0f, 60.0f }, { 3.0f, 0.0f, 60.0f }, { 3.0f, 0.0f, 60.0f }
-    };
 
 public:
-    float myElapsedTime = 0.0;  // Elapsed time for the game
-
     Music inGame;  // Background music for the game
 
     struct Canvas {  // Struct to store canvas dimensions
@@ -65,26 +71,15 @@ public:
         int* height;
     };
 
-    map<int, vector<Obstacle>> levelSpawnPoints;  // Map to store spawn points for each level
-
-    vector<EnemyTank> allEnemyTanks;  // Vector to store all enemy tanks
-    vector<EnemyTank> enemiesToBeSpawned;  // Vector to store enemies waiting to be spawned
-
-    vector<Obstacle> randomlyPickedSpawnPoints;  // Vector to store randomly picked spawn points
-
-    int highestLevelReached = 0;  // Highest level reached by the player
+    Sprite shellTexture;  // Sprite for the tank shells
 
-    Texture2D shellTexture;  // Texture for the tank shells
-
-    void loadShellTexture() {  // Load the shell texture
+    void loadShellTexture() {  // Load the shell image into the atlas
         Image image = LoadImage("img/playerTank/fireball2.png");  // Load the shell image
         ImageResize(&image, image.width / 4, image.height / 4);  // Resize the shell image
-        shellTexture = LoadTextureFromImage(image);  // Load the shell texture
-        UnloadImage(image);  // Unload the shell image
+        spriteAtlas.add("shell", image);  // The atlas unloads the image once it is packed
     }
 
-    vector<gameShellExplosionAnimation> explosions;  // Vector to store explosion animations
-    vector<Texture2D> explosionAnimationTextures;  // Vector to store explosion animation textures
+    vector<Sprite> explosionAnimationTextures;  // Vector to store explosion animation sprites
     vector<string> framePaths = {  // Paths to the explosion animation frames
         "img/MenuExplosionAnimation/frame1.png",
         "img/MenuExplosionAnimation/frame2.png",
@@ -103,40 +98,11 @@ public:
         "img/MenuExplosionAnimation/frame15.png",
         "img/MenuExplosionAnimation/frame16.png"
     };
-    float elapsedTime = 0.0f;  // Elapsed time for the explosion animation
-    float interval = 0.025f;  // Time interval between explosion frames
-    bool isExplosionActive = false;  // Flag to check if an explosion is active
-    bool isExplosionAnimationCompleted = false;  // Flag to check if the explosion animation is completed
-
-    void animationUpdater(float& deltaTime) {  // Update the explosion animation
-        elapsedTime += deltaTime;
-
-        if (elapsedTime >= interval) {
-            nextFrame();  // Advance to the next frame
-            elapsedTime = 0.0f;  // Reset the elapsed time
-        }
-    }
-
-    void nextFrame() {  // Advance the explosion animation to the next frame
-        for (auto it = explosions.begin(); it != explosions.end(); ) {
-            if (it->currentFrame < framePaths.size() - 1) {  // If the animation is not complete
-                it->currentFrame++;  // Move to the next frame
-                ++it;  // Move to the next explosion
-            } else {  // If the animation is complete
-                it = explosions.erase(it);  // Remove the explosion
-                isExplosionActive = false;  // Set the explosion flag to false
-                isExplosionAnimationCompleted = true;  // Set the animation completion flag to true
-            }
-        }
-    }
-
-    void LoadFrames(const vector<string>& filepaths) {  // Load the explosion animation frames
-        for (const auto& filepath : filepaths) {
-            Image image = LoadImage(filepath.c_str());  // Load the image
+    void LoadFrames(const vector<string>& filepaths) {  // Load the explosion animation frames into the atlas
+        for (size_t i = 0; i < filepaths.size(); i++) {
+            Image image = LoadImage(filepaths[i].c_str());  // Load the image
             ImageResize(&image, 50, 53);  // Resize the image
-            Texture2D texture = LoadTextureFromImage(image);  // Load the texture
-            explosionAnimationTextures.push_back(texture);  // Add the texture to the vector
-            UnloadImage(image);  // Unload the image
+            spriteAtlas.add("explosion/" + to_string(i), image);  // The atlas unloads the image once it is packed
         }
     }
 
@@ -144,21 +110,19 @@ public:
         LoadFrames(framePaths);
     }
 
-    void drawExplosionAnimations() {  // Draw all explosion animations
-        for (const auto& explosion : explosions) {
-            DrawTexture(explosionAnimationTextures[explosion.currentFrame],
-                explosion.position.x - explosionAnimationTextures[explosion.currentFrame].width / 2,
-                explosion.position.y - explosionAnimationTextures[explosion.currentFrame].height, WHITE);
+    void drawExplosionAnimations() {  // Queue the explosion animations on screen
+        int frameStep = qualityGovernor.getSettings().fullExplosions ? 1 : 2;  // Low tiers draw every other frame, each held twice as long
+        for (const auto& explosion : sim.explosions) {
+            const Sprite& frame = explosionAnimationTextures[explosion.currentFrame - explosion.currentFrame % frameStep];
+            if (!isVisible({ explosion.position.x - frame.width / 2, explosion.position.y - frame.height, (float)frame.width, (float)frame.height }, visibleWorld)) continue;
+
+            renderQueue.spriteAt(RENDER_FX, frame, explosion.position.x - frame.width / 2, explosion.position.y - frame.height, WHITE);
         }
     }
 
     Canvas canvas;  // Canvas dimensions
     Camera2D* camera;  // Camera for the game
 
-    vector<EnemyTank> enemyTanks;  // Vector to store enemy tanks
-
-    vector<TankShell> playerTankShells;  // Vector to store player tank shells
-
     Game(int* canvasWidth, int* canvasHeight, Camera2D* mainCamera) {  // Constructor to initialize the game
         canvas.width = canvasWidth;
         canvas.height = canvasHeight;
@@ -168,158 +132,292 @@ public:
     ~Game() {}  // Destructor
 
     void initialise(float playerTankPosX, float playerTankPosY, int& screenWidth, int& screenHeight) {  // Initialize the game
-        playerTank.initialise(playerTankPosX, playerTankPosY);  // Initialize the player tank
-        initialiseObstacles(obstacles, levelSpawnPoints);  // Initialize the obstacles
+        sim.initialise(playerTankPosX, playerTankPosY, *canvas.width, *canvas.height, camera->offset);  // Place the player tank and build the world
+        mergeStaticTiles(sim.tileMap, mergedTiles);  // Merge the tiles that never change
+        worldResolution.initialise(screenWidth, screenHeight);  // Create the offscreen world pass
+        qualityGovernor.setTargetFrameTime(1.0f / 60.0f);  // Same frame time as the target FPS
+        renderQueue.useTextCache(textCache);  // Text batches with the other draws
+        hudQueue.useTextCache(textCache);
+        seedRandom(SimRandom::freshSeed());  // A new game every time unless a seed is set before the first tick
+    }
+
+    bool startRecording(const string& path, float tickTime) {  // Record the input of every tick from the first one on
+        InputLogHeader header;
+        header.seed = sim.random.getSeed();
+        header.tickTime = tickTime;
+        header.viewOffset = sim.simCamera.offset;
+        if (!inputRecorder.open(path, header)) {
+            TraceLog(LOG_WARNING, "GAME: Could not create input log %s", path.c_str());
+            return false;
+        }
+        TraceLog(LOG_INFO, "GAME: Recording input to %s", path.c_str());
+        return true;
+    }
+
+    bool startReplay(const string& path, float tickTime) {  // Play a recorded session back from the first tick, with its seed
+        if (!inputPlayer.open(path)) {
+            TraceLog(LOG_WARNING, "GAME: Could not read input log %s", path.c_str());
+            return false;
+        }
+        if (inputPlayer.getHeader().tickTime != tickTime) {  // Ticks of another length move everything by other amounts, the replay would not match
+            TraceLog(LOG_WARNING, "GAME: Input log %s was recorded with %f s ticks, not %f s", path.c_str(), inputPlayer.getHeader().tickTime, tickTime);
+            inputPlayer.close();
+            return false;
+        }
+        seedRandom(inputPlayer.getHeader().seed);  // Same random choices as the recorded session
+        sim.simCamera.offset = inputPlayer.getHeader().viewOffset;  // Same shell ranges, whatever the screen size here
+        TraceLog(LOG_INFO, "GAME: Replaying input from %s", path.c_str());
+        return true;
+    }
+
+    bool isReplaying() const {  // Whether the input comes from a recording
+        return inputPlayer.isOpen();
+    }
+
+    void nextTickInput() {  // Take the input of the coming tick from the recording and write it to the log being recorded
+        if (inputPlayer.isOpen() && !inputPlayer.read(input)) {  // The recording ran out, the keyboard and mouse take over
+            TraceLog(LOG_INFO, "GAME: Replay finished after %ld ticks", inputPlayer.getTicks());
+            input = SimInput();
+        }
+        inputRecorder.write(input);
+    }
+
+    void seedRandom(uint64_t seed) {  // Restart the random streams from a seed and log it so the session can be replayed
+        sim.random.reseed(seed);
+        TraceLog(LOG_INFO, "GAME: Simulation seed %llu", (unsigned long long)seed);
     }
 
     void LoadTextures() {  // Load all textures
         backgroundTexture = LoadTexture("img/bg2.png");  // Load the background texture
+        SetTextureWrap(backgroundTexture, TEXTURE_WRAP_REPEAT);  // The background is one quad that repeats the texture
         loadShellTexture();  // Load the shell texture
-        enemyTankBasic = LoadTexture("img/enemyTank/enemyTankBasic.png");  // Load the enemy tank texture
-        playerTank.LoadTankTexture();  // Load the player tank textures
+        spriteAtlas.add("enemy/basic", LoadImage("img/enemyTank/enemyTankBasic.png"));  // Load the enemy tank image
+        sim.playerTank.LoadTankTexture(spriteAtlas);  // Load the player tank images
         LoadExplosionAnimationTextures();  // Load the explosion animation textures
         loadWaterTextures();  // Load the water textures
         loadTreeTexture();  // Load the tree texture
         loadBarrierTexture();  // Load the barrier texture
         loadBrickTexture();  // Load the brick texture
+        spriteAtlas.build();  // Pack every image into one texture
+        useSprites();  // Look the sprites up in the atlas
+        staticLayer.initialise(*canvas.width, *canvas.height, 16 * TileMap::tileSize, 8);  // 8 bands of 16 tile rows, enough for any screen at zoom 1
+        loadOverview();  // Build the zoomed out map
+        if (waterShader.load(TileMap::tileSize)) {  // Bake the water into the bands and animate it in the shader
+            waterShader.setStrip(waterStrip, waterFrameCount);
+        }
     }
 
-    void DrawPlayerTankAndTurret() {  // Draw the player tank and turret
-        playerTank.Draw();
+    void loadOverview() {  // Build the overview pyramid from the tile pictures
+        overviewMap.setTileImage(TILE_TREE, LoadImage("img/obstacles/tree/tree.png"));
+        overviewMap.setTileImage(TILE_BARRIER, LoadImage("img/obstacles/barrier/barrier.png"));
+        overviewMap.setTileImage(TILE_BRICK, LoadImage("img/obstacles/brick/brick.png"));
+        overviewMap.setTileImage(TILE_WATER, LoadImage("img/obstacles/water/1.png"));  // Still water, it is too small to see move
+        overviewMap.setTileColor(TILE_SPAWN, DARKPURPLE);  // Same colour as the spawn points up close
+        overviewMap.build(sim.tileMap);
     }
 
-    void drawDebug() {  // Draw debug information
-        DrawText(TextFormat("FPS: %d", GetFPS()), 50, 10, 40, DARKGRAY);  // Display the FPS
+    void useSprites() {  // Pick every sprite out of the built atlas
+        enemyTankBasic = spriteAtlas.get("enemy/basic");
+        shellTexture = spriteAtlas.get("shell");
+        brickTexture = spriteAtlas.get("brick");
+        sim.shellWidth = shellTexture.width, sim.shellHeight = shellTexture.height;  // The simulation only needs the sizes
+        sim.enemyTankWidth = enemyTankBasic.width, sim.enemyTankHeight = enemyTankBasic.height;
 
-        int yPosition = 20;  // Y position for debug text
-
-        for (int i = 0; i < 35; i++) {  // Display level data
-            if (levelData[i][1] != 0.0f) {
-                char text[100];
-                sprintf_s(text, "Level Data [%d]: { %.1f, %.1f, %.1f }", i, levelData[i][0], levelData[i][1], levelData[i][2]);
-                yPosition += 40 + 5;  // Adjust the Y position
-            }
+        explosionAnimationTextures.clear();
+        for (size_t i = 0; i < framePaths.size(); i++) {
+            explosionAnimationTextures.push_back(spriteAtlas.get("explosion/" + to_string(i)));
         }
+        sim.explosionFrameCount = (int)explosionAnimationTextures.size();
+
+        waterStrip = spriteAtlas.get("water/strip");
+
+        sim.playerTank.useSprites(spriteAtlas);
     }
 
-    void update(float& deltaTime, GameStatus& gameStatus, int& screenWidth, int& screenHeight, int& canvasWidth, int& canvasHeight) {  // Update the game state
-        myElapsedTime += deltaTime;  // Update the elapsed time
+    void DrawPlayerTankAndTurret() {  // Queue the player tank and turret
+        sim.playerTank.Draw(renderQueue, qualityGovernor.getSettings().debugOverlays, interpolation);
+    }
 
-        loadAndPlayBgMusic();  // Load and play the background music
+    void drawDebug() {  // Draw debug information as one batch of cached text
+        hudQueue.text(RENDER_HUD, TextFormat("FPS: %d", GetFPS()), 50, 10, 40, DARKGRAY);  // Display the FPS
+        hudQueue.text(RENDER_HUD, TextFormat("Quality: %d (%s)  %.1f ms  %d changes", qualityGovernor.getTier(), qualityGovernor.getSettings().name,
+            qualityGovernor.getFrameTime() * 1000.0f, (int)qualityGovernor.getHistory().size()), 50, 55, 20, DARKGRAY);  // Display the quality tier
 
-        if (playerTank.health <= 0) {  // Check if the player tank is destroyed
-            gameStatus.currentGameState = GameOver;  // Set the game state to GameOver
+        if (qualityGovernor.getSettings().debugOverlays) {  // The rest is skipped on the cheaper tiers
+            const RenderStats& renderStats = renderQueue.getStats();  // Counts of the last world flush
+            hudQueue.text(RENDER_HUD, TextFormat("Draws: %d  Batches: %d", renderStats.drawCalls, renderStats.batches), 50, 80, 20, DARKGRAY);  // Display the draw counts
+            hudQueue.text(RENDER_HUD, TextFormat("World scale: %d%%", (int)(worldResolution.getScale() * 100.0f)), 50, 105, 20, DARKGRAY);  // Display the world resolution
         }
 
-        static mt19937 gen(random_device{}());  // Random number generator
-
-        spawnEnemyTanks(playerTank.tankRect);  // Spawn enemy tanks
+        hudQueue.flush();  // Draw the HUD on top of the world
+    }
 
-        updateEnemyTanks(allEnemyTanks, playerTank.tankRect, playerTank.position.y, obstacles, *canvas.width, *canvas.height, deltaTime, playerTankShells, *camera);  // Update enemy tanks
+    void updateFrame(float deltaTime) {  // Per frame work that is not part of the simulation: quality, music, zoom and input
+        qualityGovernor.update(deltaTime);  // Pick the quality tier for this frame
+        worldResolution.setScale(qualityGovernor.getSettings().renderScale);  // World resolution of the tier
 
-        int newLevel = (canvasHeight - playerTank.GetPosition().y) / levelHeight;  // Calculate the current level
+        loadAndPlayBgMusic();  // Load and play the background music
 
-        if (newLevel != currentLevel) {  // If the level has changed
-            currentLevel = newLevel;  // Update the current level
+        readInput();  // Keyboard and mouse into the input of the next tick
 
-            if (currentLevel > highestLevelReached) {  // Update the highest level reached
-                highestLevelReached = currentLevel;
-            }
+        updateCameraZoom(deltaTime);  // Zoom in or out
 
-            if (currentLevel - 1 != -1) {  // Update the max time before the next wave
-                maxTimeBeforeNextWave = levelData[currentLevel - 1][2];
-                levelData[currentLevel][2] = maxTimeBeforeNextWave;
-            }
+        if (qualityGovernor.getSettings().animateWater) {  // Low tiers keep the water still
+            updateWaterAnimation(deltaTime);  // Update the water animation
         }
+    }
 
-        for (int lvl = 0; lvl <= highestLevelReached; lvl++) {  // Update the elapsed time for each level
-            levelData[lvl][1] += deltaTime;
+    void readInput() {  // Fill the tick input from the keyboard and mouse
+        if (inputPlayer.isOpen()) {  // A recording drives the ticks
+            sim.playerTank.updateEngineSound(input.moving());
+            return;
         }
 
-        for (int lvl = 0; lvl <= highestLevelReached; lvl++) {  // Spawn enemies for each level
-            if (levelData[lvl][1] >= levelData[lvl][2]) {  // If it's time to spawn enemies
-                if (!(levelData[lvl][2] < 10.0f)) {  // Adjust the max time before the next wave
-                    levelData[lvl][2]--;
-                }
-                levelData[lvl][1] = 0.0f;  // Reset the elapsed time
-
-                vector<int> usedSpawnPoints;  // Vector to store used spawn points
-                for (size_t i = 0; i < levelData[lvl][0]; i++) {  // Pick random spawn points
-                    while (true) {
-                        int random_index = uniform_int_distribution<int>{ 0, int(levelSpawnPoints[lvl + 1].size()) - 1 }(gen);
-                        if (find(usedSpawnPoints.begin(), usedSpawnPoints.end(), random_index) != usedSpawnPoints.end()) {
-                            continue;
-                        } else {
-                            usedSpawnPoints.push_back(random_index);
-                            break;
-                        }
-                    }
-                }
-
-                for (auto spawnpoint : usedSpawnPoints) {  // Spawn enemies at the selected spawn points
-                    int temp = 0;
-                    if (spawnpoint == 0) {
-                        temp = 10;
-                    }
-                    int random_index = uniform_int_distribution<int>{ 1, 5 }(gen);
-                    enemiesToBeSpawned.push_back(EnemyTank(BASIC,
-                        { (float)enemyTankBasic.width , (float)enemyTankBasic.height },
-                        { levelSpawnPoints[lvl + 1].at(spawnpoint).sizeAndPosition.x + temp,
-                          levelSpawnPoints[lvl + 1].at(spawnpoint).sizeAndPosition.y + (float)enemyTankBasic.height / 5 }
-                    , random_index));
-                }
-
-                levelData[lvl][0]++;  // Increase the number of enemies for the next wave
+        input.up = IsKeyDown(KEY_W);
+        input.down = IsKeyDown(KEY_S);
+        input.left = IsKeyDown(KEY_A);
+        input.right = IsKeyDown(KEY_D);
+        if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) {  // Held until a tick uses it
+            input.fire = true;
+        }
+        input.aim = GetScreenToWorld2D(GetMousePosition(), *camera);  // Aim at the mouse in the world
+
+        sim.playerTank.updateEngineSound(input.moving());  // Idle or moving engine
+    }
+
+    void playEvents() {  // Play the sounds of what happened in this frame's ticks
+        for (const auto& event : sim.events) {
+            switch (event.type) {
+            case SIM_EVENT_SHELL_FIRED:
+                sim.playerTank.playShootSound();  // Play the shooting sound
+                break;
+            case SIM_EVENT_TILE_HIT:
+            case SIM_EVENT_PLAYER_HIT:
+                sim.playerTank.playHitSound();  // Play the hit sound
+                break;
+            case SIM_EVENT_ENEMY_DESTROYED:
+                sim.playerTank.playEnemyDestroySound();  // Play the enemy destroy sound
+                break;
             }
         }
+        sim.events.clear();
+    }
 
-        animationUpdater(deltaTime);  // Update the explosion animation
+    void setInterpolation(float alpha) {  // Set how far the frame is past the last tick and move the camera to the drawn player tank
+        interpolation = alpha;
+        updateCameraToPlayerTankPosition();  // Update the camera to follow the player tank
+    }
 
-        playerTank.Update(deltaTime, GetScreenToWorld2D(GetMousePosition(), *camera), gameStatus, playerTankShells, *camera, canvasWidth, canvasHeight, obstacles, allEnemyTanks);  // Update the player tank
+    void update(float& deltaTime, GameStatus& gameStatus) {  // Advance the game by one fixed tick
+        nextTickInput();  // Recorded or live input for this tick
 
-        UpdateShells(deltaTime, screenWidth, screenHeight);  // Update the player tank shells
+        sim.tick(deltaTime, input, gameStatus);  // Collision phase, then the moves of this tick
 
-        updateCameraToPlayerTankPosition();  // Update the camera to follow the player tank
+        input.fire = false;  // The click was used
 
-        updateWaterAnimation(deltaTime);  // Update the water animation
+        for (const auto& tile : sim.publishedTiles) {  // Bricks destroyed by the collision phase
+            staticLayer.invalidate(tile);  // Bake the band again without the brick
+            overviewMap.clearTile((int)(tile.x / TileMap::tileSize), (int)(tile.y / TileMap::tileSize));  // And remove it from the overview
+        }
     }
 
-    void UpdateShells(float& deltaTime, int& screenWidth, int& screenHeight) {  // Update the player tank shells
-        for (size_t i = 0; i < playerTankShells.size(); ) {
-            playerTankShells[i].Update(deltaTime, *camera);  // Update the shell's position
-
-            if (playerTankShells[i].distanceTraveled >= playerTankShells[i].maxDistance) {  // If the shell has traveled its max distance
-                playerTankShells[i] = playerTankShells.back();  // Remove the shell
-                playerTankShells.pop_back();
-            } else {
-                ++i;  // Move to the next shell
-            }
+    void DrawShells() {  // Queue the player tank shells on screen
+        float reach = sqrtf((float)(shellTexture.width * shellTexture.width + shellTexture.height * shellTexture.height)) / 2.0f;  // Half diagonal, covers any rotation
+        for (auto& shell : sim.playerTankShells) {
+            if (!isVisible({ shell.position.x - reach, shell.position.y - reach, reach * 2, reach * 2 }, visibleWorld)) continue;
+            shell.Draw(shellTexture, renderQueue, interpolation);  // Queue the shell
         }
     }
 
-    void DrawShells() {  // Draw the player tank shells
-        for (auto& shell : playerTankShells) {
-            shell.Draw(shellTexture);  // Draw the shell
+    void updateCameraToPlayerTankPosition() {  // Update the camera to follow the player tank
+        camera->target = sim.playerTank.GetDrawPosition(interpolation);
+    }
+
+    void updateCameraZoom(float deltaTime) {  // Zoom with the mouse wheel, eased so the level of detail changes smoothly
+        float wheel = GetMouseWheelMove();
+        if (wheel != 0.0f) {
+            targetZoom = fminf(1.0f, fmaxf(minZoom, targetZoom * powf(1.25f, wheel)));  // Each notch zooms by the same factor
         }
+        camera->zoom += (targetZoom - camera->zoom) * fminf(1.0f, deltaTime * 10.0f);
     }
 
-    void updateCameraToPlayerTankPosition() {  // Update the camera to follow the player tank
-        camera->target = playerTank.GetPosition();
+    float screenZoom() {  // Zoom of the world on the screen's pixels, including the dynamic resolution
+        return camera->zoom * worldResolution.getScale();
     }
 
     void beginCamera2D() {  // Begin 2D camera mode
-        BeginMode2D(*camera);
+        visibleWorld = visibleWorldRect(*camera, GetScreenWidth(), GetScreenHeight());  // Once per frame, shared by every draw layer
+        staticLayerReady = false;
+        if (camera->zoom >= overviewZoom) {  // Close enough for the full detail bands
+            staticLayerReady = staticLayer.prepare(visibleWorld, [this](const Rectangle& band) {  // Bake the bands that came into view or changed
+                if (waterShader.isReady()) {
+                    drawWaterKeys(mergedTiles, band, waterShader.keyTile());  // The shader turns these into water when the band is drawn
+                }
+                drawGroundObstacles(sim.tileMap, mergedTiles, band, barrierTexture, brickTexture);
+            });
+        }
+        overviewActive = !staticLayerReady && overviewMap.isReady() && camera->zoom < 1.0f;  // Too many bands in view, or zoomed out past them
+        worldResolution.begin(*camera, RAYWHITE);  // The world goes into the scaled offscreen texture
+    }
+
+    void queueObstacles() {  // Queue the obstacles, the ground as whole bands or tile by tile when the bands are not ready, the trees over the tanks
+        if (overviewActive) {
+            renderQueue.custom(RENDER_OBSTACLES, [this]() { overviewMap.draw(visibleWorld, screenZoom()); });  // One quad per chunk of the chosen level, under the markers
+            return;  // The trees are part of the overview
+        }
+
+        if (staticLayerReady && waterShader.isReady()) {
+            renderQueue.custom(RENDER_OBSTACLES, [this]() {
+                waterShader.begin(spriteAtlas.getTexture(), waterAnimationTimer, waterFrameTime);
+                staticLayer.draw(visibleWorld);  // One quad per band on screen, the water inside is animated by the shader
+                waterShader.end();
+            });
+        } else if (staticLayerReady) {
+            renderQueue.custom(RENDER_WATER, [this]() { drawWater(mergedTiles, visibleWorld, waterFrame(currentWaterFrame)); });
+            renderQueue.custom(RENDER_OBSTACLES, [this]() { staticLayer.draw(visibleWorld); });  // One quad per band on screen
+        } else {
+            renderQueue.custom(RENDER_WATER, [this]() { drawWater(mergedTiles, visibleWorld, waterFrame(currentWaterFrame)); });
+            renderQueue.custom(RENDER_OBSTACLES, [this]() { drawGroundObstacles(sim.tileMap, mergedTiles, visibleWorld, barrierTexture, brickTexture); });
+        }
+        renderQueue.custom(RENDER_CANOPY, [this]() { drawTrees(mergedTiles, visibleWorld, treeTexture); });  // Over the tanks and shells
+    }
+
+    void queueImpostors() {  // Queue the tanks as plain markers, big enough to see when zoomed far out
+        float size = fmaxf(sim.playerTank.tankRect.width, 6.0f / screenZoom());  // At least 6 screen pixels
+        Vector2 player = sim.playerTank.GetDrawPosition(interpolation);
+        renderQueue.rectangle(RENDER_TANKS, { player.x - size / 2, player.y - size / 2, size, size }, LIME);
+
+        int markers = 0;
+        for (size_t i = 0; i < sim.allEnemyTanks.size(); i++) {
+            if (markers >= maxImpostors) break;  // Keep the frame inside its budget
+            Vector2 centre = sim.allEnemyTanks.centre(i);
+            Rectangle marker = { centre.x - size / 2, centre.y - size / 2, size, size };
+            if (!isVisible(marker, visibleWorld)) continue;
+
+            renderQueue.rectangle(RENDER_TANKS, marker, RED);
+            markers++;
+        }
     }
 
     void endCamera2D() {  // End 2D camera mode
-        DrawPlayerTankAndTurret();  // Draw the player tank and turret
-        drawObstacles(obstacles, currentWaterFrame, waterTextures, treeTexture, barrierTexture, brickTexture);  // Draw the obstacles
-        playerTank.drawHealthBar();  // Draw the player tank's health bar
-        drawEnemyTanks(allEnemyTanks, enemyTankBasic);  // Draw the enemy tanks
-        DrawShells();  // Draw the player tank shells
-        drawExplosionAnimations();  // Draw the explosion animations
-        enemyTracker();  // Draw enemy tracking circles
-        EndMode2D();  // End 2D camera mode
+        queueObstacles();  // Queue the obstacles
+        if (camera->zoom < impostorZoom) {  // Too far out to see the sprites, shells and explosions
+            queueImpostors();
+            renderQueue.flush();
+            worldResolution.end();
+            return;
+        }
+
+        DrawPlayerTankAndTurret();  // Queue the player tank and turret
+        sim.playerTank.drawHealthBar(renderQueue, interpolation);  // Queue the player tank's health bar
+        drawEnemyTanks(sim.allEnemyTanks, enemyTankBasic, visibleWorld, renderQueue, qualityGovernor.getSettings().debugOverlays, interpolation);  // Queue the enemy tanks
+        DrawShells();  // Queue the player tank shells
+        drawExplosionAnimations();  // Queue the explosion animations
+        if (qualityGovernor.getSettings().debugOverlays) {  // Dropped first when frames run long
+            enemyTracker();  // Queue enemy tracking circles
+        }
+        renderQueue.flush();  // Draw everything layer by layer, grouped by texture
+        worldResolution.end();  // End 2D camera mode and stretch the world onto the screen
     }
 
     void startDrawing() {  // Start drawing
@@ -331,43 +429,51 @@ public:
         EndDrawing();
     }
 
-    void loadWaterTextures() {  // Load the water textures
-        for (int i = 1; i <= 16; ++i) {
+    void loadWaterTextures() {  // Load the water images into the atlas as one strip of frames
+        int tileWidth = defaultTileWidthHeight.x, tileHeight = defaultTileWidthHeight.y;
+        Image strip = GenImageColor(tileWidth * waterFrameCount, tileHeight, BLANK);  // Frames side by side
+        for (int i = 1; i <= waterFrameCount; ++i) {
             Image image = LoadImage(("img/obstacles/water/" + to_string(i) + ".png").c_str());  // Load the water image
-            ImageResize(&image, defaultTileWidthHeight.x, defaultTileWidthHeight.y);  // Resize the water image
-            waterTextures.push_back(LoadTextureFromImage(image));  // Load the water texture
-            UnloadImage(image);  // Unload the water image
+            ImageResize(&image, tileWidth, tileHeight);  // Resize the water image
+            ImageDraw(&strip, image, { 0, 0, (float)tileWidth, (float)tileHeight }, { (float)(i - 1) * tileWidth, 0, (float)tileWidth, (float)tileHeight }, WHITE);
+            UnloadImage(image);
         }
+        spriteAtlas.add("water/strip", strip);  // The atlas unloads the image once it is packed
     }
 
-    void updateWaterAnimation(float deltaTime) {  // Update the water animation
-        waterAnimationTimer += deltaTime;
+    Sprite waterFrame(int frame) {  // Get one frame of the water strip
+        Sprite sprite = waterStrip;
+        sprite.width = waterStrip.width / waterFrameCount;
+        sprite.source.x += frame * sprite.width;
+        sprite.source.width = (float)sprite.width;
+        return sprite;
+    }
 
-        if (waterAnimationTimer >= waterFrameTime) {  // If it's time to advance the water animation
-            waterAnimationTimer -= waterFrameTime;
-            currentWaterFrame = (currentWaterFrame + 1) % waterTextures.size();  // Move to the next frame
-        }
+    void updateWaterAnimation(float deltaTime) {  // Update the water animation
+        waterAnimationTimer = fmodf(waterAnimationTimer + deltaTime, waterFrameTime * waterFrameCount);  // The shader works out the frame from this time
+        currentWaterFrame = (int)(waterAnimationTimer / waterFrameTime) % waterFrameCount;  // Frame drawn when the shader is not used
     }
 
-    void loadTreeTexture() {  // Load the tree texture
+    void loadTreeTexture() {  // Load the tree texture on its own, so it can repeat across a merged rectangle
         Image image = LoadImage("img/obstacles/tree/tree.png");  // Load the tree image
         ImageResize(&image, defaultTileWidthHeight.x, defaultTileWidthHeight.y);  // Resize the tree image
-        treeTexture = LoadTextureFromImage(image);  // Load the tree texture
-        UnloadImage(image);  // Unload the tree image
+        treeTexture = LoadTextureFromImage(image);
+        UnloadImage(image);
+        SetTextureWrap(treeTexture, TEXTURE_WRAP_REPEAT);  // One quad per merged rectangle, like the background
     }
 
-    void loadBarrierTexture() {  // Load the barrier texture
+    void loadBarrierTexture() {  // Load the barrier texture on its own, so it can repeat across a merged rectangle
         Image image = LoadImage("img/obstacles/barrier/barrier.png");  // Load the barrier image
         ImageResize(&image, defaultTileWidthHeight.x, defaultTileWidthHeight.y);  // Resize the barrier image
-        barrierTexture = LoadTextureFromImage(image);  // Load the barrier texture
-        UnloadImage(image);  // Unload the barrier image
+        barrierTexture = LoadTextureFromImage(image);
+        UnloadImage(image);
+        SetTextureWrap(barrierTexture, TEXTURE_WRAP_REPEAT);  // One quad per merged rectangle, like the background
     }
 
-    void loadBrickTexture() {  // Load the brick texture
+    void loadBrickTexture() {  // Load the brick image into the atlas
         Image image = LoadImage("img/obstacles/brick/brick.png");  // Load the brick image
         ImageResize(&image, defaultTileWidthHeight.x, defaultTileWidthHeight.y);  // Resize the brick image
-        brickTexture = LoadTextureFromImage(image);  // Load the brick texture
-        UnloadImage(image);  // Unload the brick image
+        spriteAtlas.add("brick", image);  // The atlas unloads the image once it is packed
     }
 
     void DrawBackgroundAndGrid(int canvasWidth, int canvasHeight, int gridSize) {  // Draw the background and grid
@@ -381,147 +487,42 @@ public:
         }
     }
 
-    void DrawBackgroundWithTiles(int canvasWidth, int canvasHeight, int gridSize) {  // Draw the background with tiles
-        DrawRectangle(0, 0, canvasWidth, canvasHeight, LIGHTGRAY);  // Draw the background
-
-        float scale = (float)gridSize / backgroundTexture.width;  // Calculate the scale for the background texture
-
-        for (int y = 0; y < canvasHeight; y += gridSize) {  // Draw the background tiles
-            for (int x = 0; x < canvasWidth; x += gridSize) {
-                Rectangle sourceRec = { 0.0f, 0.0f, (float)backgroundTexture.width, (float)backgroundTexture.height };  // Define the source rectangle
-                Rectangle destRec = { (float)x, (float)y, (float)gridSize, (float)gridSize };  // Define the destination rectangle
-                Vector2 origin = { 0.0f, 0.0f };  // Define the origin
-                DrawTexturePro(backgroundTexture, sourceRec, destRec, origin, 0.0f, WHITE);  // Draw the background tile
-            }
-        }
-    }
-
-    int countSpawnPoints() {  // Count the number of spawn points
-        int temp = 0;
-        for (const auto& obstacle : obstacles) {
-            if (obstacle.type == SPAWN_POINT) {
-                temp++;
-            }
-        }
-        return temp;
-    }
-
-    void checkCollisions() {  // Check for collisions between shells and obstacles/enemies
-        for (auto shellIt = playerTankShells.begin(); shellIt != playerTankShells.end();) {
-            Rectangle shellRect = {  // Define the shell's bounding rectangle
-                shellIt->GetPosition().x - shellTexture.width / 2.0f,
-                shellIt->GetPosition().y - shellTexture.height / 2.0f,
-                (float)shellTexture.width,
-                (float)shellTexture.height
-            };
-
-            bool shellCollided = false;  // Flag to check if the shell has collided
-
-            for (auto obstacleIt = obstacles.begin(); obstacleIt != obstacles.end();) {  // Check for collisions with obstacles
-                if ((obstacleIt->type == BRICK || obstacleIt->type == BARRIER) &&
-                    CheckCollisionRecs(shellRect, obstacleIt->sizeAndPosition)) {
-
-                    if (shellIt->shooter == PLAYERTANK) {  // If the shell was fired by the player
-                        playerTank.playHitSound();  // Play the hit sound
-                    }
-
-                    explosions.emplace_back(shellIt->GetPosition(), 0);  // Create an explosion
-                    shellIt = playerTankShells.erase(shellIt);  // Remove the shell
-
-                    if (obstacleIt->type != BARRIER) {  // If the obstacle is not a barrier
-                        obstacleIt = obstacles.erase(obstacleIt);  // Remove the obstacle
-                    } else {
-                        ++obstacleIt;  // Move to the next obstacle
-                    }
-
-                    shellCollided = true;  // Set the collision flag to true
-                    break;  // Exit the loop
-                } else {
-                    ++obstacleIt;  // Move to the next obstacle
-                }
-            }
-
-            if (shellCollided) {  // If the shell has collided
-                continue;  // Skip to the next shell
-            }
-
-            if (shellIt->shooter == PLAYERTANK) {  // If the shell was fired by the player
-                for (auto it = allEnemyTanks.begin(); it != allEnemyTanks.end(); ) {  // Check for collisions with enemy tanks
-                    if (CheckCollisionRecs(shellRect, it->posAndRect)) {  // If the shell collides with an enemy tank
-                        playerTank.playEnemyDestroySound();  // Play the enemy destroy sound
-                        explosions.emplace_back(Vector2{ it->centre.x , it->centre.y + 20 }, 0);  // Create an explosion
-                        shellIt = playerTankShells.erase(shellIt);  // Remove the shell
-                        it = allEnemyTanks.erase(it);  // Remove the enemy tank
-                        shellCollided = true;  // Set the collision flag to true
-                        break;  // Exit the loop
-                    } else {
-                        ++it;  // Move to the next enemy tank
-                    }
-                }
-            } else {  // If the shell was fired by an enemy
-                for (auto& enemyTank : allEnemyTanks) {  // Check for collisions with the player tank
-                    if (CheckCollisionRecs(shellRect, playerTank.tankRect)) {  // If the shell collides with the player tank
-                        playerTank.health -= 5;  // Reduce the player tank's health
-                        playerTank.playHitSound();  // Play the hit sound
-                        explosions.emplace_back(shellIt->GetPosition(), 0);  // Create an explosion
-                        shellIt = playerTankShells.erase(shellIt);  // Remove the shell
-                        shellCollided = true;  // Set the collision flag to true
-                        break;  // Exit the loop
-                    }
-                }
-            }
-            if (!shellCollided) {  // If the shell has not collided
-                ++shellIt;  // Move to the next shell
-            }
-        }
-    }
-
-    void enemyTracker() {  // Draw enemy tracking circles
-        if (allEnemyTanks.size() > 0) {  // If there are enemy tanks
-            for (const auto& enemyTank : allEnemyTanks) {  // Draw tracking circles for each enemy tank
-                DrawCircle(enemyTank.centre.x, enemyTank.centre.y, 5, RED);  // Draw the center circle
-
-                switch (enemyTank.currentDirection) {  // Draw the direction circle
-                case UP:
-                    DrawCircle(enemyTank.centre.x, enemyTank.posAndRect.y, 5, BLUE);
-                    break;
-                case RIGHT:
-                    DrawCircle(enemyTank.posAndRect.x + enemyTank.posAndRect.width, enemyTank.centre.y, 5, BLUE);
-                    break;
-                case DOWN:
-                    DrawCircle(enemyTank.centre.x, enemyTank.posAndRect.y + enemyTank.posAndRect.height, 5, BLUE);
-                    break;
-                case LEFT:
-                    DrawCircle(enemyTank.posAndRect.x, enemyTank.centre.y, 5, BLUE);
-                    break;
-                }
-            }
-        }
-    }
-
-    void spawnEnemyTanks(Rectangle playerTankRect) {  // Spawn enemy tanks
-        if (enemiesToBeSpawned.empty()) return;  // If there are no enemies to spawn, return
-
-        auto it = enemiesToBeSpawned.begin();
-        while (it != enemiesToBeSpawned.end()) {
-            bool collides = false;  // Flag to check for collisions
-
-            for (const auto& existingTank : allEnemyTanks) {  // Check for collisions with existing enemy tanks
-                if (CheckCollisionRecs(it->posAndRect, existingTank.posAndRect)) {
-                    collides = true;
-                    break;  // Exit the loop
-                }
-            }
-
-            if (CheckCollisionRecs(it->posAndRect, playerTankRect)) {  // Check for collisions with the player tank
-                collides = true;
-            }
-
-            if (!collides) {  // If there are no collisions
-                allEnemyTanks.push_back(*it);  // Add the enemy tank to the list
-                it = enemiesToBeSpawned.erase(it);  // Remove the enemy tank from the spawn list
-            } else {
-                ++it;  // Move to the next enemy tank
+    void DrawBackgroundWithTiles(int canvasWidth, int canvasHeight, int gridSize) {  // Queue the background tiles on screen as one quad
+        float left = fmaxf(0.0f, visibleWorld.x), top = fmaxf(0.0f, visibleWorld.y);  // Part of the canvas on screen
+        float right = fminf((float)canvasWidth, visibleWorld.x + visibleWorld.width), bottom = fminf((float)canvasHeight, visibleWorld.y + visibleWorld.height);
+        if (right <= left || bottom <= top) return;  // The canvas is off screen
+
+        Rectangle destRec = { left, top, right - left, bottom - top };  // Define the destination rectangle
+        renderQueue.rectangle(RENDER_GROUND, destRec, LIGHTGRAY);  // Queue the background
+
+        // One texture repeat per grid cell: the source starts at the world position in texture pixels and the wrap repeats it
+        float scaleX = (float)backgroundTexture.width / gridSize, scaleY = (float)backgroundTexture.height / gridSize;
+        Rectangle sourceRec = { destRec.x * scaleX, destRec.y * scaleY, destRec.width * scaleX, destRec.height * scaleY };  // Define the source rectangle
+        renderQueue.texture(RENDER_GROUND, backgroundTexture, sourceRec, destRec, WHITE);  // Queue the background tiles
+    }
+
+    void enemyTracker() {  // Queue enemy tracking circles
+        for (size_t i = 0; i < sim.allEnemyTanks.size(); i++) {  // Draw tracking circles for each enemy tank on screen
+            const Rectangle& posAndRect = sim.allEnemyTanks.posAndRects[i];
+            Vector2 centre = sim.allEnemyTanks.centre(i);
+            Rectangle markerBounds = { posAndRect.x - 5, posAndRect.y - 5, posAndRect.width + 10, posAndRect.height + 10 };  // Circles sit on the tank's edges
+            if (!isVisible(unionRect(markerBounds, { centre.x - 5, centre.y - 5, 10, 10 }), visibleWorld)) continue;
+
+            renderQueue.circle(RENDER_HUD, centre, 5, RED);  // Queue the center circle
+
+            switch (sim.allEnemyTanks.currentDirections[i]) {  // Queue the direction circle
+            case UP:
+                renderQueue.circle(RENDER_HUD, { centre.x, posAndRect.y }, 5, BLUE);
+                break;
+            case RIGHT:
+                renderQueue.circle(RENDER_HUD, { posAndRect.x + posAndRect.width, centre.y }, 5, BLUE);
+                break;
+            case DOWN:
+                renderQueue.circle(RENDER_HUD, { centre.x, posAndRect.y + posAndRect.height }, 5, BLUE);
+                break;
+            case LEFT:
+                renderQueue.circle(RENDER_HUD, { posAndRect.x, centre.y }, 5, BLUE);
+                break;
             }
         }
     }
@@ -540,3 +541,5 @@ public:
         }
     }
 };
+
+#endif
@@ -0,0 +1,400 @@
+#ifndef GAME_SIM_H
+#define GAME_SIM_H
+
+// Include necessary libraries and headers
+#include "simTypes.h"    // Tick input, events and value types, from raylib unless built headless
+#include "PlayerTank.h"  // Player tank first, it pulls in the enemy tanks in the order they need
+#include "obstacles.h"   // Map building
+#include "EnemyTank.h"   // Enemy tanks and the shared enemy query
+#include "TankShell.h"   // Tank shells
+#include "collision.h"   // Collision layers and contacts
+#include "entityGrid.h"  // Bucket grid of the enemy tanks
+#include "simRandom.h"   // Seeded random streams
+#include <map>           // Standard map container
+#include <vector>        // Standard vector container
+#include <algorithm>     // Standard algorithms (find, remove_if)
+#include <cmath>         // Standard math functions (INFINITY, fminf, fmaxf)
+
+using namespace std;  // Use the standard namespace
+
+// Define an explosion of the game, drawn by the front end from its frame
+class gameShellExplosionAnimation {
+public:
+    Vector2 position;  // Position of the explosion
+    int currentFrame;  // Current frame of the animation
+
+    gameShellExplosionAnimation(Vector2 pos, int currentFrame = 0)  // Constructor to initialize the explosion
+        : position(pos), currentFrame(currentFrame) {
+    }
+};
+
+// Define the GameSim class
+// Everything one tick of the game changes: the waves, the tanks, the shells, the collision phase and the explosion frames.
+// It needs no window, the sprite sizes are plain numbers, so a benchmark or a bot can run it as fast as it goes.
+// The Game feeds it the input of every tick and draws and plays what it holds afterwards.
+class GameSim {
+public:
+    TileMap tileMap;  // The world, one byte per 30px tile
+    map<int, vector<Rectangle>> levelSpawnPoints;  // Map to store spawn points for each level
+
+    PlayerTank playerTank;  // Instance of the PlayerTank class
+    EnemyTanks allEnemyTanks;  // Live enemy tanks, one array per field
+    vector<EnemyTank> enemiesToBeSpawned;  // Vector to store enemies waiting to be spawned
+    vector<TankShell> playerTankShells;  // Vector to store player tank shells
+
+    EntityGrid enemyGrid;  // Bucket grid of the enemy tanks, refilled every tick
+    vector<ContactEvent> contacts;  // Contacts found by this tick's collision phase
+    vector<Rectangle> publishedTiles;  // Tiles removed at the last publish, the front end redraws them
+
+    SimEvents events;  // What happened in the ticks since the front end last took them
+    SimRandom random;  // Seeded random streams for the waves and the enemy tanks
+    Camera2D simCamera;  // Camera the enemy shell ranges are measured with: at the player tank's tick position, never zoomed
+
+    vector<gameShellExplosionAnimation> explosions;  // Vector to store explosion animations
+    int explosionFrameCount = 16;  // Number of frames of an explosion
+    float elapsedTime = 0.0f;  // Elapsed time for the explosion animation
+    float interval = 0.025f;  // Time interval between explosion frames
+
+    int canvasWidth = 0, canvasHeight = 0;  // Size of the world
+    int shellWidth = 10, shellHeight = 25;  // Size of a shell, taken from the sprites once they are loaded
+    int enemyTankWidth = 83, enemyTankHeight = 87;  // Size of an enemy tank, taken from the sprites once they are loaded
+
+    float myElapsedTime = 0.0;  // Elapsed time for the game
+    int highestLevelReached = 0;  // Highest level reached by the player
+
+private:
+    float maxTimeBeforeNextWave = 60.0f;  // Maximum time before the next wave of enemies
+
+    int levelHeight = TileMap::tileSize * 4 * 13;  // Height of each level
+    int currentLevel = 0;  // Current level
+
+    float levelData[35][3] = {  // Data for each level (number of enemies, elapsed time, max time)
+        { 3.0f, 0.0f, 60.0f }, { 3.0f, 0.0f, 60.0f }, { 3.0f, 0.0f, 60.0f }, { 3.0f, 0.0f, 60.0f },
+        { 3.0f, 0.0f, 60.0f }, { 3.0f, 0.0f, 60.0f }, { 3.0f, 0.0f, 60.0f }, { 3.0f, 0.0f, 60.0f },
+        { 3.0f, 0.0f, 60.0f }, { 3.0f, 0.0f, 60.0f }, { 3.0f, 0.0f, 60.0f }, { 3.0f, 0.0f, 60.0f },
+        { 3.0f, 0.0f, 60.0f }, { 3.0f, 0.0f, 60.0f }, { 3.0f, 0.0f, 60.0f }, { 3.0f, 0.0f, 60.0f },
+        { 3.0f, 0.0f, 60.0f }, { 3.0f, 0.0f, 60.0f }, { 3.0f, 0.0f, 60.0f }, { 3.0f, 0.0f, 60.0f },
+        { 3.0f, 0.0f, 60.0f }, { 3.0f, 0.0f, 60.0f }, { 3.0f, 0.0f, 60.0f }, { 3.0f, 0.0f, 60.0f },
+        { 3.0f, 0.0f, 60.0f }, { 3.0f, 0.0f, 60.0f }, { 3.0f, 0.0f, 60.0f }, { 3.0f, 0.0f, 60.0f },
+        { 3.0f, 0.0f, 60.0f }, { 3.0f, 0.0f, 60.0f }, { 3.0f, 0.0f, 60.0f }, { 3.0f, 0.0f, 60.0f },
+        { 3.0f, 0.0f, 60.0f }, { 3.0f, 0.0f, 60.0f }, { 3.0f, 0.0f, 60.0f }
+    };
+
+public:
+    GameSim() {}  // Default constructor
+
+    // Build the world and place the player tank, viewOffset is the screen centre the enemy shell ranges are measured from
+    void initialise(float playerTankPosX, float playerTankPosY, int width, int height, Vector2 viewOffset) {
+        canvasWidth = width;
+        canvasHeight = height;
+        playerTank.initialise(playerTankPosX, playerTankPosY);  // Initialize the player tank
+        initialiseObstacles(tileMap, levelSpawnPoints);  // Initialize the tile map and spawn points
+        enemyGrid.resize(canvasWidth, canvasHeight);  // Allocate the enemy tank buckets
+        simCamera = { viewOffset, playerTank.position, 0.0f, 1.0f };  // The view camera before any zoom
+    }
+
+    // Advance the game by one fixed tick: the collision phase of the last tick's moves, then the moves of this one
+    void tick(float deltaTime, const SimInput& input, GameStatus& gameStatus) {
+        checkCollisions();
+        update(deltaTime, input, gameStatus);
+    }
+
+    void update(float deltaTime, const SimInput& input, GameStatus& gameStatus) {  // Move everything by one tick
+        myElapsedTime += deltaTime;  // Update the elapsed time
+        simCamera.target = playerTank.position;  // Where the player tank ended the last tick
+
+        if (playerTank.health <= 0) {  // Check if the player tank is destroyed
+            gameStatus.currentGameState = GameOver;  // Set the game state to GameOver
+        }
+
+        RandomStream& spawnRandom = random.stream(RANDOM_SPAWN);  // Spawn points and enemy timers
+
+        spawnEnemyTanks(playerTank.tankRect);  // Spawn enemy tanks
+
+        updateEnemyTanks(allEnemyTanks, enemyGrid, playerTank.tankRect, playerTank.position.y, tileMap, canvasWidth, canvasHeight, deltaTime, playerTankShells, simCamera, random.stream(RANDOM_AI));  // Update enemy tanks
+
+        int newLevel = (canvasHeight - playerTank.GetPosition().y) / levelHeight;  // Calculate the current level
+
+        if (newLevel != currentLevel) {  // If the level has changed
+            currentLevel = newLevel;  // Update the current level
+
+            if (currentLevel > highestLevelReached) {  // Update the highest level reached
+                highestLevelReached = currentLevel;
+            }
+
+            if (currentLevel - 1 != -1) {  // Update the max time before the next wave
+                maxTimeBeforeNextWave = levelData[currentLevel - 1][2];
+                levelData[currentLevel][2] = maxTimeBeforeNextWave;
+            }
+        }
+
+        for (int lvl = 0; lvl <= highestLevelReached; lvl++) {  // Update the elapsed time for each level
+            levelData[lvl][1] += deltaTime;
+        }
+
+        for (int lvl = 0; lvl <= highestLevelReached; lvl++) {  // Spawn enemies for each level
+            if (levelData[lvl][1] >= levelData[lvl][2]) {  // If it's time to spawn enemies
+                if (!(levelData[lvl][2] < 10.0f)) {  // Adjust the max time before the next wave
+                    levelData[lvl][2]--;
+                }
+                levelData[lvl][1] = 0.0f;  // Reset the elapsed time
+
+                vector<int> usedSpawnPoints;  // Vector to store used spawn points
+                for (size_t i = 0; i < levelData[lvl][0]; i++) {  // Pick random spawn points
+                    while (true) {
+                        int random_index = spawnRandom.range(0, int(levelSpawnPoints[lvl + 1].size()) - 1);
+                        if (find(usedSpawnPoints.begin(), usedSpawnPoints.end(), random_index) != usedSpawnPoints.end()) {
+                            continue;
+                        } else {
+                            usedSpawnPoints.push_back(random_index);
+                            break;
+                        }
+                    }
+                }
+
+                for (auto spawnpoint : usedSpawnPoints) {  // Spawn enemies at the selected spawn points
+                    int temp = 0;
+                    if (spawnpoint == 0) {
+                        temp = 10;
+                    }
+                    int random_index = spawnRandom.range(1, 5);
+                    enemiesToBeSpawned.push_back(EnemyTank(BASIC,
+                        { (float)enemyTankWidth , (float)enemyTankHeight },
+                        { levelSpawnPoints[lvl + 1].at(spawnpoint).x + temp,
+                          levelSpawnPoints[lvl + 1].at(spawnpoint).y + (float)enemyTankHeight / 5 }
+                    , random_index));
+                }
+
+                levelData[lvl][0]++;  // Increase the number of enemies for the next wave
+            }
+        }
+
+        animationUpdater(deltaTime);  // Update the explosion animation
+
+        playerTank.Update(deltaTime, input, events, gameStatus, playerTankShells, canvasWidth, canvasHeight, tileMap, allEnemyTanks, enemyGrid);  // Update the player tank
+
+        UpdateShells(deltaTime);  // Update the player tank shells
+    }
+
+    void animationUpdater(float deltaTime) {  // Update the explosion animation
+        elapsedTime += deltaTime;
+
+        if (elapsedTime >= interval) {
+            nextFrame();  // Advance to the next frame
+            elapsedTime = 0.0f;  // Reset the elapsed time
+        }
+    }
+
+    void nextFrame() {  // Advance the explosion animation to the next frame (the same on every quality tier, it is part of the tick)
+        for (auto it = explosions.begin(); it != explosions.end(); ) {
+            if (it->currentFrame + 1 < explosionFrameCount) {  // If the animation is not complete
+                it->currentFrame++;  // Move to the next frame
+                ++it;  // Move to the next explosion
+            } else {  // If the animation is complete
+                it = explosions.erase(it);  // Remove the explosion
+            }
+        }
+    }
+
+    Rectangle shellRectAt(Vector2 position) {  // Get the bounding rectangle of a shell centred on a position
+        return { position.x - shellWidth / 2.0f, position.y - shellHeight / 2.0f, (float)shellWidth, (float)shellHeight };
+    }
+
+    void computeShellImpact(TankShell& shell) {  // Raycast the shell's path through the tile map
+        float hitDistance;  // Distance from the start of the path to the first tile hit
+
+        // Swept from where the shell started, the float error its position has picked up in flight stays out of the impact point
+        // Tiles are only ever removed, so none can appear on the part of the path the shell has already flown.
+        if (tileMap.sweep(shellRectAt(shell.StartPosition), shell.direction, shell.maxDistance, TILE_BLOCKS_SHELLS, hitDistance, shell.impactColumn, shell.impactRow)) {
+            shell.impactDistance = hitDistance;
+        } else {
+            shell.impactDistance = INFINITY;  // The shell reaches its max distance without hitting a tile
+        }
+
+        shell.impactDirty = false;
+    }
+
+    void invalidateShellImpacts(Rectangle destroyedTile) {  // Recompute the impact of every shell whose remaining path crosses a destroyed tile
+        for (auto& shell : playerTankShells) {
+            if (shell.spent || shell.impactDirty || shell.impactDistance == INFINITY) continue;  // No impact that could change
+
+            float remaining = shell.impactDistance - shell.distanceTraveled;  // Distance left to the impact point
+            Rectangle from = shellRectAt(shell.GetPosition());  // The shell now
+            Rectangle to = shellRectAt({ shell.position.x + shell.direction.x * remaining, shell.position.y + shell.direction.y * remaining });  // The shell at its impact point
+            Rectangle path = {  // Bounds of the remaining path
+                fminf(from.x, to.x), fminf(from.y, to.y),
+                fmaxf(from.x, to.x) - fminf(from.x, to.x) + from.width,
+                fmaxf(from.y, to.y) - fminf(from.y, to.y) + from.height
+            };
+
+            if (CheckCollisionRecs(path, destroyedTile)) {  // The destroyed tile may have been in the way
+                shell.impactDirty = true;
+            }
+        }
+    }
+
+    void UpdateShells(float deltaTime) {  // Update the player tank shells
+        for (size_t i = 0; i < playerTankShells.size(); ) {
+            if (playerTankShells[i].impactDirty) {  // New shell, or a brick on its path was destroyed
+                computeShellImpact(playerTankShells[i]);
+            }
+
+            playerTankShells[i].Update(deltaTime);  // Update the shell's position (it stops at its impact point)
+
+            if (playerTankShells[i].distanceTraveled >= playerTankShells[i].maxDistance && !playerTankShells[i].reachedImpact()) {  // If the shell has traveled its max distance
+                playerTankShells[i] = playerTankShells.back();  // Remove the shell
+                playerTankShells.pop_back();
+            } else {
+                ++i;  // Move to the next shell
+            }
+        }
+    }
+
+    int countSpawnPoints() {  // Count the number of spawn points
+        int temp = 0;
+        for (const auto& level : levelSpawnPoints) {
+            temp += level.second.size();
+        }
+        return temp;
+    }
+
+    CollisionLayer shellLayer(const TankShell& shell) {  // Get the collision layer of a shell from its shooter
+        return shell.shooter == PLAYERTANK ? LAYER_PLAYER_SHELL : LAYER_ENEMY_SHELL;
+    }
+
+    void detectContacts() {  // Find what each shell runs into this tick, without changing anything
+        contacts.clear();  // Start with an empty contact list
+
+        for (int i = 0; i < (int)playerTankShells.size(); i++) {  // Each shell is tested once and gets at most one contact
+            TankShell& shell = playerTankShells[i];
+            CollisionLayer layer = shellLayer(shell);  // Layer of the shell
+            Rectangle shellRect = shellRectAt(shell.GetPosition());  // Define the shell's bounding rectangle
+
+            if (layersCollide(layer, LAYER_SOLID_TILE) && shell.reachedImpact()) {  // The shell arrived at the brick or barrier its path runs into
+                contacts.push_back({ layer, i, LAYER_SOLID_TILE, -1, shell.impactColumn, shell.impactRow });
+                continue;  // Skip to the next shell
+            }
+
+            if (layersCollide(layer, LAYER_ENEMY)) {  // Check for collisions with enemy tanks
+                int hit = findOverlappingEnemy(shellRect, shellRect, allEnemyTanks, nullptr, enemyGrid, allEnemyTanks.nearbyTanks);
+                if (hit >= 0) {
+                    contacts.push_back({ layer, i, LAYER_ENEMY, hit, -1, -1 });
+                    continue;
+                }
+            }
+
+            if (layersCollide(layer, LAYER_PLAYER) && CheckCollisionRecs(shellRect, playerTank.tankRect)) {  // Check for a collision with the player tank
+                contacts.push_back({ layer, i, LAYER_PLAYER, -1, -1, -1 });
+            }
+        }
+    }
+
+    void resolveContacts(bool& anyShellSpent, bool& anyEnemyDestroyed) {  // Apply the damage, events and explosions of the contacts found this tick
+        for (const auto& contact : contacts) {
+            TankShell& shell = playerTankShells[contact.index];
+
+            switch (contact.otherLayer) {
+            case LAYER_SOLID_TILE:
+                if (!tileMap.blocksShells(contact.column, contact.row)) {  // The tile was destroyed by another shell this tick
+                    shell.impactDirty = true;  // Find the next tile on the path
+                    break;
+                }
+
+                if (contact.layer == LAYER_PLAYER_SHELL) {  // If the shell was fired by the player
+                    events.push_back({ SIM_EVENT_TILE_HIT, shell.GetPosition() });  // The front end plays the hit sound
+                }
+
+                explosions.emplace_back(shell.GetPosition(), 0);  // Create an explosion
+                shell.spent = true;  // Remove the shell
+                anyShellSpent = true;
+
+                if (tileMap.isDestructible(contact.column, contact.row)) {  // If the tile is a brick
+                    tileMap.queueClear(contact.column, contact.row);  // Remove the brick at the end of the collision phase
+                }
+                break;
+
+            case LAYER_ENEMY: {
+                if (allEnemyTanks.destroyed[contact.otherIndex]) break;  // Another shell got there first, this one flies on
+
+                Vector2 centre = allEnemyTanks.centre(contact.otherIndex);
+                events.push_back({ SIM_EVENT_ENEMY_DESTROYED, centre });  // The front end plays the enemy destroy sound
+                explosions.emplace_back(Vector2{ centre.x , centre.y + 20 }, 0);  // Create an explosion
+                shell.spent = true;  // Remove the shell
+                allEnemyTanks.destroyed[contact.otherIndex] = 1;  // Remove the enemy tank
+                anyShellSpent = anyEnemyDestroyed = true;
+                break;
+            }
+
+            case LAYER_PLAYER:
+                playerTank.health -= 5;  // Reduce the player tank's health
+                events.push_back({ SIM_EVENT_PLAYER_HIT, shell.GetPosition() });  // The front end plays the hit sound
+                explosions.emplace_back(shell.GetPosition(), 0);  // Create an explosion
+                shell.spent = true;  // Remove the shell
+                anyShellSpent = true;
+                break;
+
+            default:
+                break;
+            }
+        }
+    }
+
+    void checkCollisions() {  // Collision phase of the tick: find the contacts, apply them, then remove what was hit
+        rebuildEnemyGrid(enemyGrid, allEnemyTanks);  // Index the enemy tanks by position
+
+        detectContacts();  // Contacts only refer to indices, so nothing moves until they have all been found
+
+        bool anyShellSpent = false;  // Whether a shell has to be removed after the pass
+        bool anyEnemyDestroyed = false;  // Whether an enemy tank has to be removed after the pass
+        resolveContacts(anyShellSpent, anyEnemyDestroyed);
+
+        // Remove the spent shells in a single compaction pass and the destroyed tanks by moving the last tank into each hole
+        if (anyShellSpent) {
+            playerTankShells.erase(remove_if(playerTankShells.begin(), playerTankShells.end(), [](const TankShell& shell) { return shell.spent; }), playerTankShells.end());
+        }
+        if (anyEnemyDestroyed) {
+            allEnemyTanks.removeDestroyed();
+            rebuildEnemyGrid(enemyGrid, allEnemyTanks);  // The removal moved tanks to new rows
+        }
+
+        publishDestroyedTiles();  // The world changes here and nowhere else during the tick
+    }
+
+    void publishDestroyedTiles() {  // Sync point: apply this tick's brick destructions to the tile map
+        if (tileMap.publish(publishedTiles) == 0) return;  // Nothing was destroyed
+
+        for (const auto& tile : publishedTiles) {
+            invalidateShellImpacts(tile);  // Shells aimed past a destroyed brick get a new impact point
+        }
+    }
+
+    void spawnEnemyTanks(Rectangle playerTankRect) {  // Spawn enemy tanks
+        if (enemiesToBeSpawned.empty()) return;  // If there are no enemies to spawn, return
+
+        size_t waiting = 0;  // Tanks kept in the spawn list, packed to the front in their order
+        for (size_t i = 0; i < enemiesToBeSpawned.size(); i++) {
+            const EnemyTank& enemyTank = enemiesToBeSpawned[i];
+            bool collides = false;  // Flag to check for collisions
+
+            if (findOverlappingEnemy(enemyTank.posAndRect, enemyTank.posAndRect, allEnemyTanks, nullptr, enemyGrid, allEnemyTanks.nearbyTanks) >= 0) {  // Check for collisions with existing enemy tanks
+                collides = true;
+            }
+
+            if (CheckCollisionRecs(enemyTank.posAndRect, playerTankRect)) {  // Check for collisions with the player tank
+                collides = true;
+            }
+
+            if (!collides) {  // If there are no collisions
+                int row = allEnemyTanks.add(enemyTank);  // Add the enemy tank to the list
+                if (row >= enemyGridThreshold && enemyGrid.size() == row) {  // The grid is in use, later spawns must see it there too
+                    enemyGrid.insert(row, enemyTank.posAndRect);
+                }
+            } else {
+                enemiesToBeSpawned[waiting++] = enemyTank;  // Try again next tick
+            }
+        }
+        enemiesToBeSpawned.erase(enemiesToBeSpawned.begin() + waiting, enemiesToBeSpawned.end());  // Drop the spawned tanks in one go
+    }
+};
+
+#endif
@@ -0,0 +1,174 @@
+#ifndef INPUT_LOG_H
+#define INPUT_LOG_H
+
+// Include necessary libraries and headers
+#include "simTypes.h"  // Tick input recorded and replayed
+#include <fstream>     // Standard file streams
+#include <string>      // Standard string class for file names
+#include <cstdint>     // Fixed width integer types
+
+using namespace std;  // Use the standard namespace
+
+// Define what a session needs besides its input to replay the same way
+struct InputLogHeader {
+    uint64_t seed = 0;            // Seed of the random streams
+    float tickTime = 0.0f;        // Length of a tick
+    Vector2 viewOffset = { 0, 0 };  // Screen centre the simulation measures enemy shell ranges from
+};
+
+// Define the bits of the flag byte written for every tick
+enum InputLogFlag : unsigned char {
+    INPUT_LOG_UP = 1 << 0,
+    INPUT_LOG_DOWN = 1 << 1,
+    INPUT_LOG_LEFT = 1 << 2,
+    INPUT_LOG_RIGHT = 1 << 3,
+    INPUT_LOG_FIRE = 1 << 4,
+    INPUT_LOG_AIM = 1 << 5   // The aim point changed, two floats follow
+};
+
+static const char inputLogMagic[4] = { 'B', 'T', 'I', 'N' };  // First bytes of every log
+static const uint32_t inputLogVersion = 1;                     // Layout of the log
+
+// Define the InputRecorder class
+// Writes one flag byte per tick, plus the aim point when it moved, so an idle mouse costs a byte a tick.
+// The file stream buffers the writes, nothing is kept in memory. Numbers are written in the machine's byte order.
+class InputRecorder {
+private:
+    ofstream file;               // Log being written
+    Vector2 lastAim = { 0, 0 };  // Aim point written last
+    bool aimWritten = false;     // Whether an aim point was written yet
+    long ticks = 0;              // Ticks written
+
+public:
+    InputRecorder() {}  // Default constructor
+
+    // Start a log, returns false if the file cannot be created
+    bool open(const string& path, const InputLogHeader& header) {
+        file.open(path, ios::binary | ios::trunc);
+        if (!file) return false;
+
+        file.write(inputLogMagic, sizeof(inputLogMagic));
+        file.write((const char*)&inputLogVersion, sizeof(inputLogVersion));
+        file.write((const char*)&header.seed, sizeof(header.seed));
+        file.write((const char*)&header.tickTime, sizeof(header.tickTime));
+        file.write((const char*)&header.viewOffset, sizeof(header.viewOffset));
+        aimWritten = false;
+        ticks = 0;
+        return (bool)file;
+    }
+
+    // Whether a log is being written
+    bool isOpen() const {
+        return file.is_open();
+    }
+
+    // Write the input of one tick
+    void write(const SimInput& input) {
+        if (!file.is_open()) return;
+
+        unsigned char flags = (input.up ? INPUT_LOG_UP : 0) | (input.down ? INPUT_LOG_DOWN : 0) | (input.left ? INPUT_LOG_LEFT : 0)
+            | (input.right ? INPUT_LOG_RIGHT : 0) | (input.fire ? INPUT_LOG_FIRE : 0);
+        bool aimMoved = !aimWritten || input.aim.x != lastAim.x || input.aim.y != lastAim.y;
+        if (aimMoved) flags |= INPUT_LOG_AIM;
+
+        file.put((char)flags);
+        if (aimMoved) {
+            file.write((const char*)&input.aim, sizeof(input.aim));
+            lastAim = input.aim;
+            aimWritten = true;
+        }
+        ticks++;
+    }
+
+    // Get the number of ticks written
+    long getTicks() const {
+        return ticks;
+    }
+
+    // Finish the log
+    void close() {
+        if (file.is_open()) file.close();
+    }
+};
+
+// Define the InputPlayer class
+// Reads a log written by InputRecorder back one tick at a time
+class InputPlayer {
+private:
+    ifstream file;               // Log being read
+    InputLogHeader header;       // Header of the log
+    Vector2 lastAim = { 0, 0 };  // Aim point read last
+    long ticks = 0;              // Ticks read
+
+public:
+    InputPlayer() {}  // Default constructor
+
+    // Open a log, returns false if it is missing or not an input log
+    bool open(const string& path) {
+        file.open(path, ios::binary);
+        if (!file) return false;
+
+        char magic[4] = {};
+        uint32_t version = 0;
+        file.read(magic, sizeof(magic));
+        file.read((char*)&version, sizeof(version));
+        file.read((char*)&header.seed, sizeof(header.seed));
+        file.read((char*)&header.tickTime, sizeof(header.tickTime));
+        file.read((char*)&header.viewOffset, sizeof(header.viewOffset));
+        if (!file || string(magic, 4) != string(inputLogMagic, 4) || version != inputLogVersion) {
+            file.close();
+            return false;
+        }
+        ticks = 0;
+        return true;
+    }
+
+    // Whether a log is being read
+    bool isOpen() const {
+        return file.is_open();
+    }
+
+    // Get the header of the log
+    const InputLogHeader& getHeader() const {
+        return header;
+    }
+
+    // Read the input of the next tick, returns false and closes the log at its end
+    bool read(SimInput& input) {
+        if (!file.is_open()) return false;
+
+        int flags = file.get();
+        if (flags == EOF) {
+            file.close();
+            return false;
+        }
+        if (flags & INPUT_LOG_AIM) {
+            file.read((char*)&lastAim, sizeof(lastAim));
+            if (!file) {  // Cut off in the middle of a tick
+                file.close();
+                return false;
+            }
+        }
+
+        input.up = (flags & INPUT_LOG_UP) != 0;
+        input.down = (flags & INPUT_LOG_DOWN) != 0;
+        input.left = (flags & INPUT_LOG_LEFT) != 0;
+        input.right = (flags & INPUT_LOG_RIGHT) != 0;
+        input.fire = (flags & INPUT_LOG_FIRE) != 0;
+        input.aim = lastAim;
+        ticks++;
+        return true;
+    }
+
+    // Get the number of ticks read
+    long getTicks() const {
+        return ticks;
+    }
+
+    // Stop reading the log
+    void close() {
+        if (file.is_open()) file.close();
+    }
+};
+
+#endif
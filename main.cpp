@@ -1,8 +1,25 @@
 # include "window.h"    // include window header
+#ifdef COLLISION_SELF_CHECK
+# include "collisionCheck.h"    // include the collision self check
+#endif
 
-int main()              // main function
+int main(int argc, char* argv[])              // main function
 {
+#ifdef COLLISION_SELF_CHECK
+    return runCollisionSelfChecks();    // compare the collision structures with plain loops instead of starting the game
+#endif
+    string recordPath, replayPath;      // input log to write and to play back, if any
+    bool fast = false;                  // play the log back as fast as possible
+    for (int i = 1; i < argc; i++) {    // read the command line options
+        string option = argv[i];
+        if (option == "--record" && i + 1 < argc) recordPath = argv[++i];
+        else if (option == "--replay" && i + 1 < argc) replayPath = argv[++i];
+        else if (option == "--fast") fast = true;
+    }
+
     Window window;      // Create an instance of the window class
+    if (!replayPath.empty()) window.replay(replayPath, fast);    // replay first, the recording takes the replay's seed
+    if (!recordPath.empty()) window.record(recordPath);
     window.run();       // run the run member function
     return 0;           
 }
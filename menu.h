@@ -203,6 +203,7 @@ private:
     Rectangle buttons[3];  // Buttons for the menu
     Color buttonColors[3] = { LIGHTGRAY, LIGHTGRAY, LIGHTGRAY };  // Colors for the buttons
     const char* buttonText[3] = { "Play", "Scoreboard", "Exit" };  // Text for the buttons
+    int buttonTextWidth[3] = { 0, 0, 0 };  // Width of each button's text, measured once
     float totalHeight = 3 * 50 + 2 * 50;  // Total height of the buttons
 
     MainMenuTank theMainMenuTank;  // The tank in the main menu
@@ -252,6 +253,9 @@ public:
         buttons[0] = { screenWidth / 2.0f - 100, startY - 75, 200, 50 };  // Define the "Play" button
         buttons[1] = { screenWidth / 2.f + 200.0f, startY - 75, 200, 50 };  // Define the "Scoreboard" button
         buttons[2] = { screenWidth / 2.f - 400.0f, startY - 75, 200, 50 };  // Define the "Exit" button
+        for (int i = 0; i < 3; i++) {  // The labels never change, measure them once
+            buttonTextWidth[i] = MeasureText(buttonText[i], 20);
+        }
 
         shootingSoundArray[0] = LoadSound("sounds/shot2.mp3");  // Load the shooting sound
         for (int i = 1; i < MAX_SOUNDS; i++) {  // Create aliases for the shooting sound
@@ -365,7 +369,7 @@ public:
         for (int i = 0; i < 3; i++) {  // Draw the buttons
             DrawRectangleRec(buttons[i], buttonColors[i]);
             DrawText(buttonText[i],
-                buttons[i].x + buttons[i].width / 2 - MeasureText(buttonText[i], 20) / 2,
+                buttons[i].x + buttons[i].width / 2 - buttonTextWidth[i] / 2,
                 buttons[i].y + buttons[i].height / 2 - 10, 20, BLACK);
         }
 
@@ -2,10 +2,16 @@
 #define OBSTACLES_H
 
 // Include necessary libraries and headers
-#include "raylib.h"  // Raylib library for graphics and input handling
+#include "simTypes.h"  // Value types, from raylib unless built headless
 #include <map>       // Standard map container
 #include <vector>    // Standard vector container
 #include <iostream>  // Standard input/output stream
+#include "tileMap.h"  // Packed tile storage for the world
+#include "viewport.h"  // Visible part of the world
+#ifndef SIM_HEADLESS
+#include "textureAtlas.h"  // Sprites drawn from the atlas
+#endif
+#include <algorithm>  // Standard algorithms (lower_bound)
 
 using namespace std;  // Use the standard namespace
 
@@ -30,22 +36,6 @@ enum ObstacleType {
     SPAWN_POINT  // Represents a spawn point
 };
 
-// Define the Obstacle class
-class Obstacle {
-public:
-    ObstacleType type;  // The type of obstacle
-    Rectangle sizeAndPosition;  // The size and position of the obstacle
-
-    bool damageable;  // Whether the obstacle can be damaged
-    int damageLevel;  // The current damage level of the obstacle
-
-    // Constructor for the Obstacle class
-    Obstacle(ObstacleType ObstacleType, Rectangle sizeAndPosition, bool damageable = false, int damageLevel = 2)
-        : type(ObstacleType), sizeAndPosition(sizeAndPosition) {
-    }
-
-};
-
 // Define a 2D array representing the obstacle map
 ObstacleType tempObstacleMap[455][13] = {
     // The map is filled with various obstacle types to represent the game world
@@ -543,301 +533,235 @@ ObstacleType tempObstacleMap[455][13] = {
 
 };
 
-// Function to initialize obstacles based on the obstacle map
-void initialiseObstacles(vector<Obstacle>& obstacles, map<int, vector<Obstacle>>& levelSpawnPoints) {
+// Function to fill part of a 4x4 tile block with one tile type
+void fillBlock(TileMap& tileMap, int mapRow, int mapColumn, TileType type, int firstColumn, int lastColumn, int firstRow, int lastRow) {
+    for (int row = firstRow; row <= lastRow; row++) {
+        for (int column = firstColumn; column <= lastColumn; column++) {
+            tileMap.set(mapColumn * 4 + column, mapRow * 4 + row, type);
+        }
+    }
+}
 
-    Vector2 defaultTileWidthHeight = { 30,30 };  // Default size of each tile
-    float TileSpacer = defaultTileWidthHeight.x;  // Spacing between tiles
+// Function to initialize the tile map and the spawn points based on the obstacle map
+void initialiseObstacles(TileMap& tileMap, map<int, vector<Rectangle>>& levelSpawnPoints) {
 
-    float tempWidth = 0;  // Temporary variable to track the width position
-    float tempHeight = 0;  // Temporary variable to track the height position
+    float blockSize = TileMap::tileSize * 4;  // Every map cell covers 4x4 tiles
 
-    int tempLevel = 35;  // Temporary variable to track the current level
-    vector<Obstacle> tempSpawns;  // Temporary vector to store spawn points for the current level
+    tileMap.resize(13 * 4, 455 * 4);  // One tile map entry per 30px tile
 
     // Loop through each row and column of the obstacle map
     for (int i = 0; i < 454; ++i) {
         for (int j = 0; j < 13; ++j) {
-            // Check the type of obstacle at the current position
-            if (tempObstacleMap[i][j] != SPACE) {
-                // Depending on the obstacle type, create the corresponding obstacles
-                if (tempObstacleMap[i][j] == BRICK_BLOCK) {
-                    // Create a full brick block by adding multiple brick obstacles
-                    obstacles.push_back(Obstacle(BRICK, { tempWidth, tempHeight, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(BRICK, { tempWidth + TileSpacer, tempHeight, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(BRICK, { tempWidth + TileSpacer * 2, tempHeight, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(BRICK, { tempWidth + TileSpacer * 3, tempHeight, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-
-                    obstacles.push_back(Obstacle(BRICK, { tempWidth, tempHeight + TileSpacer, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(BRICK, { tempWidth + TileSpacer, tempHeight + TileSpacer, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(BRICK, { tempWidth + TileSpacer * 2, tempHeight + TileSpacer, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(BRICK, { tempWidth + TileSpacer * 3, tempHeight + TileSpacer, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-
-                    obstacles.push_back(Obstacle(BRICK, { tempWidth, tempHeight + TileSpacer * 2, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(BRICK, { tempWidth + TileSpacer, tempHeight + TileSpacer * 2, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(BRICK, { tempWidth + TileSpacer * 2, tempHeight + TileSpacer * 2, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(BRICK, { tempWidth + TileSpacer * 3, tempHeight + TileSpacer * 2, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-
-                    obstacles.push_back(Obstacle(BRICK, { tempWidth, tempHeight + TileSpacer * 3, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(BRICK, { tempWidth + TileSpacer, tempHeight + TileSpacer * 3, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(BRICK, { tempWidth + TileSpacer * 2, tempHeight + TileSpacer * 3, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(BRICK, { tempWidth + TileSpacer * 3, tempHeight + TileSpacer * 3, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-
-                }
-
-                if (tempObstacleMap[i][j] == BARRIER_BLOCK) {
-                    obstacles.push_back(Obstacle(BARRIER, { tempWidth, tempHeight, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(BARRIER, { tempWidth + TileSpacer, tempHeight, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(BARRIER, { tempWidth + TileSpacer * 2, tempHeight, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(BARRIER, { tempWidth + TileSpacer * 3, tempHeight, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-
-                    obstacles.push_back(Obstacle(BARRIER, { tempWidth, tempHeight + TileSpacer, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(BARRIER, { tempWidth + TileSpacer, tempHeight + TileSpacer, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(BARRIER, { tempWidth + TileSpacer * 2, tempHeight + TileSpacer, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(BARRIER, { tempWidth + TileSpacer * 3, tempHeight + TileSpacer, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-
-                    obstacles.push_back(Obstacle(BARRIER, { tempWidth, tempHeight + TileSpacer * 2, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(BARRIER, { tempWidth + TileSpacer, tempHeight + TileSpacer * 2, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(BARRIER, { tempWidth + TileSpacer * 2, tempHeight + TileSpacer * 2, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(BARRIER, { tempWidth + TileSpacer * 3, tempHeight + TileSpacer * 2, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-
-                    obstacles.push_back(Obstacle(BARRIER, { tempWidth, tempHeight + TileSpacer * 3, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(BARRIER, { tempWidth + TileSpacer, tempHeight + TileSpacer * 3, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(BARRIER, { tempWidth + TileSpacer * 2, tempHeight + TileSpacer * 3, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(BARRIER, { tempWidth + TileSpacer * 3, tempHeight + TileSpacer * 3, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                }
-
-                if (tempObstacleMap[i][j] == TREE_BLOCK)
-                {
-                    obstacles.push_back(Obstacle(TREE, { tempWidth, tempHeight, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(TREE, { tempWidth + TileSpacer, tempHeight, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(TREE, { tempWidth + TileSpacer * 2, tempHeight, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(TREE, { tempWidth + TileSpacer * 3, tempHeight, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-
-                    obstacles.push_back(Obstacle(TREE, { tempWidth, tempHeight + TileSpacer, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(TREE, { tempWidth + TileSpacer, tempHeight + TileSpacer, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(TREE, { tempWidth + TileSpacer * 2, tempHeight + TileSpacer, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(TREE, { tempWidth + TileSpacer * 3, tempHeight + TileSpacer, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-
-                    obstacles.push_back(Obstacle(TREE, { tempWidth, tempHeight + TileSpacer * 2, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(TREE, { tempWidth + TileSpacer, tempHeight + TileSpacer * 2, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(TREE, { tempWidth + TileSpacer * 2, tempHeight + TileSpacer * 2, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(TREE, { tempWidth + TileSpacer * 3, tempHeight + TileSpacer * 2, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-
-                    obstacles.push_back(Obstacle(TREE, { tempWidth, tempHeight + TileSpacer * 3, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(TREE, { tempWidth + TileSpacer, tempHeight + TileSpacer * 3, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(TREE, { tempWidth + TileSpacer * 2, tempHeight + TileSpacer * 3, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(TREE, { tempWidth + TileSpacer * 3, tempHeight + TileSpacer * 3, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-
-                }
-
-                if (tempObstacleMap[i][j] == HALF_LOWER_BARRIER_BLOCK) {
-
-                    obstacles.push_back(Obstacle(BARRIER, { tempWidth, tempHeight + TileSpacer * 2, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(BARRIER, { tempWidth + TileSpacer, tempHeight + TileSpacer * 2, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(BARRIER, { tempWidth + TileSpacer * 2, tempHeight + TileSpacer * 2, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(BARRIER, { tempWidth + TileSpacer * 3, tempHeight + TileSpacer * 2, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-
-                    obstacles.push_back(Obstacle(BARRIER, { tempWidth, tempHeight + TileSpacer * 3, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(BARRIER, { tempWidth + TileSpacer, tempHeight + TileSpacer * 3, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(BARRIER, { tempWidth + TileSpacer * 2, tempHeight + TileSpacer * 3, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(BARRIER, { tempWidth + TileSpacer * 3, tempHeight + TileSpacer * 3, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                }
-
-                if (tempObstacleMap[i][j] == HALF_LEFT_BRICK_BLOCK) {
-
-                    obstacles.push_back(Obstacle(BRICK, { tempWidth, tempHeight, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(BRICK, { tempWidth + TileSpacer, tempHeight, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-
-                    obstacles.push_back(Obstacle(BRICK, { tempWidth, tempHeight + TileSpacer, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(BRICK, { tempWidth + TileSpacer, tempHeight + TileSpacer, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-
-                    obstacles.push_back(Obstacle(BRICK, { tempWidth, tempHeight + TileSpacer * 2, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(BRICK, { tempWidth + TileSpacer, tempHeight + TileSpacer * 2, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-
-                    obstacles.push_back(Obstacle(BRICK, { tempWidth, tempHeight + TileSpacer * 3, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(BRICK, { tempWidth + TileSpacer, tempHeight + TileSpacer * 3, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-
-                }
-
-                if (tempObstacleMap[i][j] == HALF_UPPER_BRICK_BLOCK) {
-                    obstacles.push_back(Obstacle(BRICK, { tempWidth, tempHeight, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(BRICK, { tempWidth + TileSpacer, tempHeight, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(BRICK, { tempWidth + TileSpacer * 2, tempHeight, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(BRICK, { tempWidth + TileSpacer * 3, tempHeight, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-
-                    obstacles.push_back(Obstacle(BRICK, { tempWidth, tempHeight + TileSpacer, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(BRICK, { tempWidth + TileSpacer, tempHeight + TileSpacer, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(BRICK, { tempWidth + TileSpacer * 2, tempHeight + TileSpacer, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(BRICK, { tempWidth + TileSpacer * 3, tempHeight + TileSpacer, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-
-                }
-
-                if (tempObstacleMap[i][j] == HALF_RIGHT_BRICK_BLOCK) {
-
-                    obstacles.push_back(Obstacle(BRICK, { tempWidth + TileSpacer * 2, tempHeight, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(BRICK, { tempWidth + TileSpacer * 3, tempHeight, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-
-                    obstacles.push_back(Obstacle(BRICK, { tempWidth + TileSpacer * 2, tempHeight + TileSpacer, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(BRICK, { tempWidth + TileSpacer * 3, tempHeight + TileSpacer, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-
-                    obstacles.push_back(Obstacle(BRICK, { tempWidth + TileSpacer * 2, tempHeight + TileSpacer * 2, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(BRICK, { tempWidth + TileSpacer * 3, tempHeight + TileSpacer * 2, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-
-                    obstacles.push_back(Obstacle(BRICK, { tempWidth + TileSpacer * 2, tempHeight + TileSpacer * 3, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(BRICK, { tempWidth + TileSpacer * 3, tempHeight + TileSpacer * 3, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-
-                }
-                if (tempObstacleMap[i][j] == HALF_LOWER_BRICK_BLOCK)
-                {
-
-                    obstacles.push_back(Obstacle(BRICK, { tempWidth, tempHeight + TileSpacer * 2, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(BRICK, { tempWidth + TileSpacer, tempHeight + TileSpacer * 2, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(BRICK, { tempWidth + TileSpacer * 2, tempHeight + TileSpacer * 2, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(BRICK, { tempWidth + TileSpacer * 3, tempHeight + TileSpacer * 2, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-
-                    obstacles.push_back(Obstacle(BRICK, { tempWidth, tempHeight + TileSpacer * 3, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(BRICK, { tempWidth + TileSpacer, tempHeight + TileSpacer * 3, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(BRICK, { tempWidth + TileSpacer * 2, tempHeight + TileSpacer * 3, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(BRICK, { tempWidth + TileSpacer * 3, tempHeight + TileSpacer * 3, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-
+            // Expand the cell into its tiles
+            switch (tempObstacleMap[i][j]) {
+            case BRICK_BLOCK: fillBlock(tileMap, i, j, TILE_BRICK, 0, 3, 0, 3); break;
+            case BARRIER_BLOCK: fillBlock(tileMap, i, j, TILE_BARRIER, 0, 3, 0, 3); break;
+            case TREE_BLOCK: fillBlock(tileMap, i, j, TILE_TREE, 0, 3, 0, 3); break;
+            case WATER: fillBlock(tileMap, i, j, TILE_WATER, 0, 3, 0, 3); break;
+            case HALF_LOWER_BARRIER_BLOCK: fillBlock(tileMap, i, j, TILE_BARRIER, 0, 3, 2, 3); break;
+            case HALF_UPPER_BARRIER_BLOCK: fillBlock(tileMap, i, j, TILE_BARRIER, 0, 3, 0, 1); break;
+            case HALF_LEFT_BARRIER_BLOCK: fillBlock(tileMap, i, j, TILE_BARRIER, 0, 1, 0, 3); break;
+            case HALF_RIGHT_BARRIER_BLOCK: fillBlock(tileMap, i, j, TILE_BARRIER, 2, 3, 0, 3); break;
+            case HALF_LOWER_BRICK_BLOCK: fillBlock(tileMap, i, j, TILE_BRICK, 0, 3, 2, 3); break;
+            case HALF_UPPER_BRICK_BLOCK: fillBlock(tileMap, i, j, TILE_BRICK, 0, 3, 0, 1); break;
+            case HALF_LEFT_BRICK_BLOCK: fillBlock(tileMap, i, j, TILE_BRICK, 0, 1, 0, 3); break;
+            case HALF_RIGHT_BRICK_BLOCK: fillBlock(tileMap, i, j, TILE_BRICK, 2, 3, 0, 3); break;
+            case SPACE:
+                // Empty cells on the first row of a level are spawn points
+                if (i % 13 == 0) {
+                    fillBlock(tileMap, i, j, TILE_SPAWN, 0, 3, 0, 3);
                 }
+                break;
+            default:
+                break;
+            }
+        }
+    }
 
-                if (tempObstacleMap[i][j] == HALF_LEFT_BARRIER_BLOCK) {
+    // Collect the spawn points of every level from the tile map (level 35 is at the top of the canvas)
+    for (int i = 0; i < 454; i += 13) {
+        vector<Rectangle> spawns;  // Spawn points of the current level
+        for (int j = 0; j < 13; ++j) {
+            if (tileMap.at(j * 4, i * 4) == TILE_SPAWN) {
+                spawns.push_back({ j * blockSize, i * blockSize, blockSize, blockSize });
+            }
+        }
+        levelSpawnPoints[35 - i / 13] = spawns;
+    }
+}
 
-                    obstacles.push_back(Obstacle(BARRIER, { tempWidth, tempHeight, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(BARRIER, { tempWidth + TileSpacer, tempHeight, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
+// Define a rectangle of identical static tiles merged at level build time
+struct MergedTile {
+    TileType type;   // Type of every tile inside the rectangle
+    Rectangle area;  // World rectangle covered by the merged tiles
+    int columns;     // Width of the rectangle in tiles
+    int rows;        // Height of the rectangle in tiles
+};
 
-                    obstacles.push_back(Obstacle(BARRIER, { tempWidth, tempHeight + TileSpacer, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(BARRIER, { tempWidth + TileSpacer, tempHeight + TileSpacer, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
+// Define the list of merged static tiles
+struct MergedTiles {
+    vector<MergedTile> tiles;  // Rectangles in order of their top edge
+    float tallest = 0.0f;      // Height of the tallest rectangle (the furthest above the view one can start and still show)
+};
 
-                    obstacles.push_back(Obstacle(BARRIER, { tempWidth, tempHeight + TileSpacer * 2, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(BARRIER, { tempWidth + TileSpacer, tempHeight + TileSpacer * 2, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
+// Function to check whether a tile type never changes during a game (everything except bricks)
+bool isStaticTile(TileType type) {
+    return type == TILE_BARRIER || type == TILE_WATER || type == TILE_TREE || type == TILE_SPAWN;
+}
 
-                    obstacles.push_back(Obstacle(BARRIER, { tempWidth, tempHeight + TileSpacer * 3, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(BARRIER, { tempWidth + TileSpacer, tempHeight + TileSpacer * 3, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
+// Function to merge neighbouring static tiles of the same type into as few rectangles as possible
+// Greedy: grow a run to the right from the first unmerged tile, then grow it down while every tile under it matches.
+void mergeStaticTiles(const TileMap& tileMap, MergedTiles& mergedTiles) {
+    mergedTiles.tiles.clear();
+    mergedTiles.tallest = 0.0f;
+    vector<bool> merged((size_t)tileMap.columns * tileMap.rows, false);  // Tiles already inside a rectangle
+
+    for (int row = 0; row < tileMap.rows; row++) {
+        for (int column = 0; column < tileMap.columns; column++) {
+            TileType type = tileMap.at(column, row);
+            if (!isStaticTile(type) || merged[(size_t)row * tileMap.columns + column]) continue;
+
+            // Grow to the right
+            int width = 1;
+            while (column + width < tileMap.columns && tileMap.at(column + width, row) == type && !merged[(size_t)row * tileMap.columns + column + width]) {
+                width++;
+            }
 
+            // Grow down while the whole row below matches
+            int height = 1;
+            while (row + height < tileMap.rows) {
+                bool rowMatches = true;
+                for (int x = column; x < column + width; x++) {
+                    if (tileMap.at(x, row + height) != type || merged[(size_t)(row + height) * tileMap.columns + x]) {
+                        rowMatches = false;
+                        break;
+                    }
                 }
+                if (!rowMatches) break;
+                height++;
+            }
 
-                if (tempObstacleMap[i][j] == HALF_UPPER_BARRIER_BLOCK) {
-                    obstacles.push_back(Obstacle(BARRIER, { tempWidth, tempHeight, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(BARRIER, { tempWidth + TileSpacer, tempHeight, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(BARRIER, { tempWidth + TileSpacer * 2, tempHeight, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(BARRIER, { tempWidth + TileSpacer * 3, tempHeight, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-
-                    obstacles.push_back(Obstacle(BARRIER, { tempWidth, tempHeight + TileSpacer, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(BARRIER, { tempWidth + TileSpacer, tempHeight + TileSpacer, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(BARRIER, { tempWidth + TileSpacer * 2, tempHeight + TileSpacer, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(BARRIER, { tempWidth + TileSpacer * 3, tempHeight + TileSpacer, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-
+            // Mark the tiles as merged
+            for (int y = row; y < row + height; y++) {
+                for (int x = column; x < column + width; x++) {
+                    merged[(size_t)y * tileMap.columns + x] = true;
                 }
+            }
 
-                if (tempObstacleMap[i][j] == WATER)
-                {
-                    obstacles.push_back(Obstacle(WATER, { tempWidth, tempHeight, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(WATER, { tempWidth + TileSpacer, tempHeight, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(WATER, { tempWidth + TileSpacer * 2, tempHeight, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(WATER, { tempWidth + TileSpacer * 3, tempHeight, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-
-                    obstacles.push_back(Obstacle(WATER, { tempWidth, tempHeight + TileSpacer, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(WATER, { tempWidth + TileSpacer, tempHeight + TileSpacer, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(WATER, { tempWidth + TileSpacer * 2, tempHeight + TileSpacer, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(WATER, { tempWidth + TileSpacer * 3, tempHeight + TileSpacer, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-
-                    obstacles.push_back(Obstacle(WATER, { tempWidth, tempHeight + TileSpacer * 2, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(WATER, { tempWidth + TileSpacer, tempHeight + TileSpacer * 2, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(WATER, { tempWidth + TileSpacer * 2, tempHeight + TileSpacer * 2, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(WATER, { tempWidth + TileSpacer * 3, tempHeight + TileSpacer * 2, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-
-                    obstacles.push_back(Obstacle(WATER, { tempWidth, tempHeight + TileSpacer * 3, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(WATER, { tempWidth + TileSpacer, tempHeight + TileSpacer * 3, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(WATER, { tempWidth + TileSpacer * 2, tempHeight + TileSpacer * 3, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(WATER, { tempWidth + TileSpacer * 3, tempHeight + TileSpacer * 3, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-
-                }
+            mergedTiles.tiles.push_back({ type, { column * TileMap::tileSize, row * TileMap::tileSize, width * TileMap::tileSize, height * TileMap::tileSize }, width, height });
+            mergedTiles.tallest = fmaxf(mergedTiles.tallest, height * TileMap::tileSize);  // Rows are scanned top to bottom, so the list stays sorted by top edge
+        }
+    }
+}
 
-                if (tempObstacleMap[i][j] == HALF_RIGHT_BARRIER_BLOCK) {
+#ifndef SIM_HEADLESS  // Drawing, only in the windowed game
 
-                    obstacles.push_back(Obstacle(BARRIER, { tempWidth + TileSpacer * 2, tempHeight, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(BARRIER, { tempWidth + TileSpacer * 3, tempHeight, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
+// Function to draw the visible part of a merged rectangle, one sprite per tile (atlas sprites cannot wrap, the quads share one batch)
+void drawRepeatedSprite(const Sprite& sprite, const MergedTile& mergedTile, const Rectangle& view) {
+    int firstColumn = (int)fmaxf(0.0f, floorf((view.x - mergedTile.area.x) / TileMap::tileSize));  // Tiles of the rectangle inside the view
+    int firstRow = (int)fmaxf(0.0f, floorf((view.y - mergedTile.area.y) / TileMap::tileSize));
+    int lastColumn = (int)fminf((float)mergedTile.columns, ceilf((view.x + view.width - mergedTile.area.x) / TileMap::tileSize)) - 1;
+    int lastRow = (int)fminf((float)mergedTile.rows, ceilf((view.y + view.height - mergedTile.area.y) / TileMap::tileSize)) - 1;
 
-                    obstacles.push_back(Obstacle(BARRIER, { tempWidth + TileSpacer * 2, tempHeight + TileSpacer, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(BARRIER, { tempWidth + TileSpacer * 3, tempHeight + TileSpacer, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
+    for (int row = firstRow; row <= lastRow; row++) {
+        for (int column = firstColumn; column <= lastColumn; column++) {
+            drawSprite(sprite,
+                { mergedTile.area.x + column * TileMap::tileSize, mergedTile.area.y + row * TileMap::tileSize, TileMap::tileSize, TileMap::tileSize },
+                { 0, 0 }, 0.0f, WHITE);
+        }
+    }
+}
 
-                    obstacles.push_back(Obstacle(BARRIER, { tempWidth + TileSpacer * 2, tempHeight + TileSpacer * 2, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(BARRIER, { tempWidth + TileSpacer * 3, tempHeight + TileSpacer * 2, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
+// Function to draw the visible part of a merged rectangle as one quad, the texture must be set to TEXTURE_WRAP_REPEAT
+void drawRepeatedTexture(const Texture2D& texture, const MergedTile& mergedTile, const Rectangle& view) {
+    float left = fmaxf(mergedTile.area.x, view.x), top = fmaxf(mergedTile.area.y, view.y);  // Part of the rectangle inside the view
+    float right = fminf(mergedTile.area.x + mergedTile.area.width, view.x + view.width);
+    float bottom = fminf(mergedTile.area.y + mergedTile.area.height, view.y + view.height);
+    if (right <= left || bottom <= top) return;  // Nothing of it on screen
 
-                    obstacles.push_back(Obstacle(BARRIER, { tempWidth + TileSpacer * 2, tempHeight + TileSpacer * 3, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
-                    obstacles.push_back(Obstacle(BARRIER, { tempWidth + TileSpacer * 3, tempHeight + TileSpacer * 3, defaultTileWidthHeight.x, defaultTileWidthHeight.y }));
+    float scaleX = (float)texture.width / TileMap::tileSize, scaleY = (float)texture.height / TileMap::tileSize;  // Texture pixels per world unit
+    Rectangle source = { (left - mergedTile.area.x) * scaleX, (top - mergedTile.area.y) * scaleY, (right - left) * scaleX, (bottom - top) * scaleY };
+    DrawTexturePro(texture, source, { left, top, right - left, bottom - top }, { 0, 0 }, 0.0f, WHITE);  // The source runs past the texture and wraps once per tile
+}
 
-                }
+// Function to find the first merged rectangle that can reach into the view (the list is sorted by top edge)
+vector<MergedTile>::const_iterator firstMergedTileFor(const MergedTiles& mergedTiles, const Rectangle& view) {
+    return lower_bound(mergedTiles.tiles.begin(), mergedTiles.tiles.end(), view.y - mergedTiles.tallest,
+        [](const MergedTile& mergedTile, float top) { return mergedTile.area.y < top; });  // Starts too far above the view to reach into it
+}
 
-            }
-           else if (tempObstacleMap[i][j] == SPACE) {
-               // If the current position is empty, check if it's a spawn point
-               if (i % 13 == 0 || i == 0) {
-                   // Create a spawn point obstacle
-                   obstacles.push_back(Obstacle(SPAWN_POINT, { tempWidth, tempHeight, TileSpacer * 4, TileSpacer * 4 }));
-                   tempSpawns.push_back(Obstacle(SPAWN_POINT, { tempWidth, tempHeight, TileSpacer * 4, TileSpacer * 4 }));
-               }
-            }
+// Function to draw the water inside the visible part of the world with one frame of the water strip
+// The frame is a sprite of the atlas, which cannot wrap, so this fallback for a missing water shader still draws a quad per tile
+void drawWater(const MergedTiles& mergedTiles, const Rectangle& view, const Sprite& waterFrame) {
+    if (waterFrame.texture.id == 0) return;  // No frame to draw
 
-            tempWidth += TileSpacer * 4;  // Move to the next tile position horizontally
+    for (auto it = firstMergedTileFor(mergedTiles, view); it != mergedTiles.tiles.end() && it->area.y < view.y + view.height; ++it) {
+        if (it->type == TILE_WATER && isVisible(it->area, view)) {
+            drawRepeatedSprite(waterFrame, *it, view);  // Draw water using the current frame of the water animation
         }
+    }
+}
 
-        // After processing a row, check if it's the end of a level
-        if (i % 13 == 0) {
-            // Store the spawn points for the current level
-            levelSpawnPoints[tempLevel] = tempSpawns;
-            tempLevel--;  // Move to the next level
-            tempSpawns.clear();  // Clear the temporary spawn points vector
+// Function to draw the water as key pixels for the water shader (baked once, the shader animates them)
+// The keys have no alpha, so they are copied into the band without blending. Water never overlaps another tile.
+void drawWaterKeys(const MergedTiles& mergedTiles, const Rectangle& view, const Texture2D& waterKey) {
+    BeginBlendMode(BLEND_ALPHA_PREMULTIPLY);  // Source plus destination: the key lands unchanged on the cleared band
+    for (auto it = firstMergedTileFor(mergedTiles, view); it != mergedTiles.tiles.end() && it->area.y < view.y + view.height; ++it) {
+        if (it->type == TILE_WATER && isVisible(it->area, view)) {
+            drawRepeatedTexture(waterKey, *it, view);  // One quad per merged rectangle, the key tile repeats across it
         }
-
-        tempHeight += TileSpacer * 4;  // Move to the next row position vertically
-        tempWidth = 0;  // Reset the horizontal position
     }
+    EndBlendMode();
 }
 
-// Function to draw obstacles on the screen
-void drawObstacles(vector<Obstacle>& obstacles, int& currentWaterFrame,
-    vector<Texture2D>& waterTextures,
-    Texture2D& treeTexture,
-    Texture2D& barrierTexture,
-    Texture2D& brickTexture) {
-    // Loop through each obstacle and draw it based on its type
-    for (const auto& obstacle : obstacles) {
-        if (obstacle.type == WATER) {
-            // Draw water using the current frame of the water animation
-            int frameIndex = currentWaterFrame;
-            if (frameIndex < waterTextures.size()) {
-                DrawTexturePro(
-                    waterTextures[frameIndex],
-                    Rectangle{ 0, 0, (float)waterTextures[frameIndex].width, (float)waterTextures[frameIndex].height },
-                    obstacle.sizeAndPosition,
-                    Vector2{ 0, 0 },
-                    0.0f,
-                    WHITE
-                );
-            }
+// Function to draw the obstacles on the ground that only change when a brick is destroyed (barriers, spawn points and bricks)
+void drawGroundObstacles(TileMap& tileMap, const MergedTiles& mergedTiles, const Rectangle& view,
+    const Texture2D& barrierTexture,
+    Sprite& brickTexture) {
+    // Draw the static tiles, one quad per merged rectangle
+    for (auto it = firstMergedTileFor(mergedTiles, view); it != mergedTiles.tiles.end() && it->area.y < view.y + view.height; ++it) {
+        const MergedTile& mergedTile = *it;
+        if (!isVisible(mergedTile.area, view)) continue;  // Ends above the view or lies beside it
+
+        // Draw barriers and spawn points based on their type
+        if (mergedTile.type == TILE_BARRIER) {
+            drawRepeatedTexture(barrierTexture, mergedTile, view);
         }
 
-        // Draw trees, barriers, bricks, and spawn points based on their type
-        if (obstacle.type == TREE) {
-            DrawTexture(treeTexture, obstacle.sizeAndPosition.x, obstacle.sizeAndPosition.y, WHITE);
+        if (mergedTile.type == TILE_SPAWN) {
+            DrawRectangleRec(mergedTile.area, DARKPURPLE);
         }
+    }
 
-        if (obstacle.type == BARRIER) {
-            DrawTexture(barrierTexture, obstacle.sizeAndPosition.x, obstacle.sizeAndPosition.y, WHITE);
-        }
+    // Draw the bricks one tile at a time, they can be destroyed individually
+    int firstColumn, lastColumn, firstRow, lastRow;
+    if (!tileMap.tileRange(view, firstColumn, lastColumn, firstRow, lastRow)) return;  // The view lies outside the map
+    uint64_t visibleColumns = TileMap::columnSpan(firstColumn, lastColumn);
 
-        if (obstacle.type == BRICK) {
-            DrawTexture(brickTexture, obstacle.sizeAndPosition.x, obstacle.sizeAndPosition.y, WHITE);
+    for (int row = firstRow; row <= lastRow; row++) {  // Only the rows on screen
+        uint64_t solid = tileMap.rowMask(row, TILE_BLOCKS_SHELLS) & visibleColumns;  // Bricks and barriers in this row
+        while (solid) {
+            int column = TileMap::lowestColumn(solid);
+            solid &= solid - 1;  // Clear the bit to move on to the next tile
+
+            if (tileMap.at(column, row) == TILE_BRICK) {
+                Rectangle tile = tileMap.tileRect(column, row);
+                drawSpriteAt(brickTexture, tile.x, tile.y, WHITE);
+            }
         }
+    }
+}
 
-        if (obstacle.type == SPAWN_POINT) {
-            DrawRectangle(obstacle.sizeAndPosition.x, obstacle.sizeAndPosition.y, obstacle.sizeAndPosition.width, obstacle.sizeAndPosition.height, DARKPURPLE);
+// Function to draw the trees inside the visible part of the world, they cover the tanks driving under them
+// Every tree rectangle is one quad of the same texture, so they all go out in a single batch and need no baking.
+void drawTrees(const MergedTiles& mergedTiles, const Rectangle& view, const Texture2D& treeTexture) {
+    for (auto it = firstMergedTileFor(mergedTiles, view); it != mergedTiles.tiles.end() && it->area.y < view.y + view.height; ++it) {
+        if (it->type == TILE_TREE && isVisible(it->area, view)) {
+            drawRepeatedTexture(treeTexture, *it, view);
         }
     }
 }
 
+#endif  // SIM_HEADLESS
+
 #endif
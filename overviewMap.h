@@ -0,0 +1,144 @@
+#ifndef OVERVIEW_MAP_H
+#define OVERVIEW_MAP_H
+
+// Include necessary libraries and headers
+#include "raylib.h"   // Raylib library for images and textures
+#include "tileMap.h"  // The tiles the overview is made from
+#include <vector>     // Standard vector container
+#include <cmath>      // Standard math functions (floor, ceil)
+
+using namespace std;  // Use the standard namespace
+
+// Define the OverviewMap class
+// A pyramid of small copies of the tile map for a zoomed out camera: each level draws a tile with 8, 4, 2 or 1 pixels
+// and is cut into chunks of rows, one texture each. The level is picked from how big a tile is on screen, so a view
+// of the whole map costs one quad per chunk instead of one per tile.
+class OverviewMap {
+private:
+    static const int levelCount = 4;                   // Number of levels in the pyramid
+    int tilePixels[levelCount] = { 8, 4, 2, 1 };       // Pixels per tile at each level, finest first
+    vector<Texture2D> chunks[levelCount];              // Chunk textures of each level, top to bottom
+    int chunkRows = 64;                                // Tile rows in a chunk
+    Image tileImages[TILE_TYPE_COUNT] = {};            // Picture of each tile type, shrunk for every level
+    Color tileColors[TILE_TYPE_COUNT] = {};            // Flat colour of the tile types without a picture
+    int columns = 0;                                   // Size of the map in tiles
+    int rows = 0;
+    bool ready = false;                                // Whether the chunk textures were created
+
+    // Get the pixels of one tile type at a level, a block of size x size colours
+    vector<Color> tileBlock(TileType type, int size) {
+        vector<Color> block((size_t)size * size, tileColors[type]);
+        if (tileImages[type].data == nullptr) return block;  // Flat colour
+
+        Image small = ImageCopy(tileImages[type]);
+        ImageResize(&small, size, size);
+        Color* pixels = LoadImageColors(small);
+        if (pixels != nullptr) {
+            for (int i = 0; i < size * size; i++) block[i] = pixels[i];
+            UnloadImageColors(pixels);
+        }
+        UnloadImage(small);
+        return block;
+    }
+
+public:
+    OverviewMap() {}  // Default constructor
+
+    // Set the picture of a tile type, the overview takes the image over and unloads it after build()
+    void setTileImage(TileType type, Image image) {
+        tileImages[type] = image;
+    }
+
+    // Set a flat colour for a tile type without a picture (e.g. spawn points)
+    void setTileColor(TileType type, Color color) {
+        tileColors[type] = color;
+    }
+
+    // Draw every level of the pyramid from the tile map, returns false if a texture could not be created
+    bool build(const TileMap& tileMap) {
+        columns = tileMap.columns;
+        rows = tileMap.rows;
+        ready = true;
+
+        for (int level = 0; level < levelCount; level++) {
+            int size = tilePixels[level];
+            vector<Color> blocks[TILE_TYPE_COUNT];
+            for (int type = 0; type < TILE_TYPE_COUNT; type++) {
+                blocks[type] = tileBlock((TileType)type, size);
+            }
+
+            for (int firstRow = 0; firstRow < rows; firstRow += chunkRows) {
+                int chunkHeight = firstRow + chunkRows > rows ? rows - firstRow : chunkRows;  // The last chunk may be shorter
+                int width = columns * size, height = chunkHeight * size;
+                vector<Color> pixels((size_t)width * height);
+
+                for (int row = 0; row < chunkHeight; row++) {
+                    for (int column = 0; column < columns; column++) {
+                        const vector<Color>& block = blocks[tileMap.at(column, firstRow + row)];
+                        for (int y = 0; y < size; y++) {
+                            for (int x = 0; x < size; x++) {
+                                pixels[(size_t)(row * size + y) * width + column * size + x] = block[y * size + x];
+                            }
+                        }
+                    }
+                }
+
+                Image image = { pixels.data(), width, height, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 };  // Borrowed pixels, not unloaded
+                Texture2D texture = LoadTextureFromImage(image);
+                if (texture.id == 0) ready = false;
+                chunks[level].push_back(texture);
+            }
+        }
+
+        for (auto& image : tileImages) {  // The levels are built, the pictures are not needed any more
+            if (image.data != nullptr) UnloadImage(image);
+            image = Image();
+        }
+        return ready;
+    }
+
+    // Whether the overview can be drawn
+    bool isReady() const {
+        return ready;
+    }
+
+    // Get the level to draw at a zoom, the coarsest one that still has a pixel for every screen pixel of a tile
+    int levelFor(float zoom) const {
+        float screenPixels = TileMap::tileSize * zoom;  // Size of a tile on screen
+        for (int level = levelCount - 1; level > 0; level--) {
+            if (tilePixels[level] >= screenPixels) return level;
+        }
+        return 0;
+    }
+
+    // Empty a tile on every level (a destroyed brick)
+    void clearTile(int column, int row) {
+        if (!ready || column < 0 || column >= columns || row < 0 || row >= rows) return;
+
+        vector<Color> blank((size_t)tilePixels[0] * tilePixels[0], tileColors[TILE_EMPTY]);  // Big enough for every level
+        for (int level = 0; level < levelCount; level++) {
+            int size = tilePixels[level];
+            Rectangle area = { (float)(column * size), (float)((row % chunkRows) * size), (float)size, (float)size };
+            UpdateTextureRec(chunks[level][row / chunkRows], area, blank.data());
+        }
+    }
+
+    // Draw the chunks in view at the level for the zoom (inside the world camera)
+    void draw(const Rectangle& view, float zoom) {
+        if (!ready) return;
+
+        int level = levelFor(zoom);
+        float chunkHeight = chunkRows * TileMap::tileSize;  // Height of a chunk in the world
+        int firstChunk = (int)fmaxf(0.0f, floorf(view.y / chunkHeight));
+        int lastChunk = (int)fminf((float)chunks[level].size(), ceilf((view.y + view.height) / chunkHeight)) - 1;
+
+        for (int chunk = firstChunk; chunk <= lastChunk; chunk++) {
+            const Texture2D& texture = chunks[level][chunk];
+            Rectangle source = { 0.0f, 0.0f, (float)texture.width, (float)texture.height };
+            Rectangle dest = { 0.0f, chunk * chunkHeight, columns * TileMap::tileSize, (float)texture.height / tilePixels[level] * TileMap::tileSize };
+            DrawTexturePro(texture, source, dest, { 0.0f, 0.0f }, 0.0f, WHITE);
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,115 @@
+#ifndef QUALITY_GOVERNOR_H
+#define QUALITY_GOVERNOR_H
+
+// Include necessary libraries and headers
+#include <deque>  // Standard double ended queue for the decision history
+#include <cmath>  // Standard math functions (fminf)
+
+using namespace std;  // Use the standard namespace
+
+// Define what a quality tier turns on or off
+struct QualitySettings {
+    const char* name;          // Short name shown in the debug text
+    bool debugOverlays;        // Enemy trackers and debug text in the world
+    float renderScale;         // Fraction of the screen size the world is drawn at
+    bool fullExplosions;       // Every explosion frame (every other frame otherwise, each held twice as long)
+    bool animateWater;         // Water animation (frozen on its current frame otherwise)
+};
+
+// Define a tier change made by the governor
+struct QualityDecision {
+    float time;              // Game time of the change
+    int fromTier;            // Tier before the change
+    int toTier;              // Tier after the change
+    float frameTime;         // Smoothed frame time that caused it
+};
+
+// Define the QualityGovernor class
+// It watches the frame time and steps to a cheaper tier while frames take longer than the target. After a calm spell it
+// tries the next better tier again; the calm spell doubles every time that had to be taken back, so it settles instead of flickering.
+class QualityGovernor {
+public:
+    static const int tierCount = 6;  // Number of tiers, 0 is full quality
+
+private:
+    QualitySettings tiers[tierCount] = {
+        { "full",            true,  1.0f,   true,  true  },
+        { "no overlays",     false, 1.0f,   true,  true  },
+        { "scale 87%",       false, 0.875f, true,  true  },
+        { "half explosions", false, 0.75f,  false, true  },
+        { "still water",     false, 0.625f, false, false },
+        { "minimum",         false, 0.5f,   false, false }
+    };
+
+    int tier = 0;                            // Current tier
+    float targetFrameTime = 1.0f / 60.0f;    // Frame time to hold
+    float smoothedFrameTime = 1.0f / 60.0f;  // Frame time averaged over the last frames
+    float clock = 0.0f;                      // Time the governor has been running
+    float sinceChange = 0.0f;                // Time since the tier last changed
+    float calmTime = 0.0f;                   // Time the frames have been within the target
+    float retryDelay = 2.0f;                 // Calm time needed before trying a better tier
+    bool improvedLast = false;               // Whether the last change was to a better tier
+    deque<QualityDecision> history;          // Latest tier changes, oldest first
+    size_t historyLength = 32;               // Number of changes kept
+
+    // Move to another tier and remember why
+    void changeTier(int newTier) {
+        history.push_back({ clock, tier, newTier, smoothedFrameTime });
+        if (history.size() > historyLength) history.pop_front();
+
+        improvedLast = newTier < tier;
+        tier = newTier;
+        calmTime = sinceChange = 0.0f;
+    }
+
+public:
+    QualityGovernor() {}  // Default constructor
+
+    // Set the frame time to hold
+    void setTargetFrameTime(float frameTime) {
+        targetFrameTime = smoothedFrameTime = frameTime;
+    }
+
+    // Feed the time of the last frame and change the tier if needed
+    void update(float frameTime) {
+        clock += frameTime;
+        smoothedFrameTime += (frameTime - smoothedFrameTime) * 0.1f;  // Ignore single slow frames
+        sinceChange += frameTime;
+        if (sinceChange < 0.5f) return;  // Let the average settle after a change
+
+        if (smoothedFrameTime > targetFrameTime * 1.15f) {  // Missing the target, drop a tier
+            calmTime = 0.0f;
+            if (tier == tierCount - 1) return;
+            if (improvedLast) retryDelay = fminf(retryDelay * 2.0f, 32.0f);  // The last improvement was too much
+            changeTier(tier + 1);
+        } else if (smoothedFrameTime <= targetFrameTime * 1.05f) {  // Headroom, try a better tier after a while
+            calmTime += frameTime;
+            if (calmTime < retryDelay || tier == 0) return;
+            changeTier(tier - 1);
+        } else {
+            calmTime = 0.0f;
+        }
+    }
+
+    // Get the current tier
+    int getTier() const {
+        return tier;
+    }
+
+    // Get what the current tier turns on or off
+    const QualitySettings& getSettings() const {
+        return tiers[tier];
+    }
+
+    // Get the smoothed frame time the decisions are based on
+    float getFrameTime() const {
+        return smoothedFrameTime;
+    }
+
+    // Get the latest tier changes, oldest first
+    const deque<QualityDecision>& getHistory() const {
+        return history;
+    }
+};
+
+#endif
@@ -1,4 +1,5 @@
 #include "raylib.h"  // Include the main Raylib library
+#include "fixedTimestep.h"  // Include the fixed ticks the animation is counted in
 
 class RaylibLogoAnimation {
 private:
@@ -9,6 +10,8 @@ private:
 
     float alpha = 1.0f;  // Variable to control the transparency of the logo
 
+    FixedTimestep ticks;  // The counters below count 60 ticks a second, whatever the frame rate
+
 public:
     bool animationCompleted = false;  // Flag to indicate if the animation is completed
 
@@ -19,10 +22,22 @@ public:
         logoPositionY = screenHeight / 2 - 128;  // Set the Y position of the logo to the center of the screen
     }
 
-    void Update() {  // Function to update the animation
+    void Update(float deltaTime) {  // Function to update the animation
+        if (state == 4) {  // Checked every frame so a key press is never missed between ticks
+            tick();
+            return;
+        }
+
+        ticks.advance(deltaTime);
+        while (ticks.step()) {  // Advance the animation once per tick
+            tick();
+        }
+    }
+
+    void tick() {  // Function to advance the animation by one tick
         if (state == 0) {  // State 0: Initial delay before the animation starts
             framesCounter++;  // Increment the frame counter
-            if (framesCounter == 120) {  // After 120 frames, move to the next state
+            if (framesCounter == 120) {  // After 120 ticks, move to the next state
                 state = 1;
                 framesCounter = 0;  // Reset the frame counter
             }
@@ -41,7 +56,7 @@ public:
         }
         else if (state == 3) {  // State 3: Fade out the logo and display the text
             framesCounter++;  // Increment the frame counter
-            if (framesCounter % 12 == 0) {  // Every 12 frames, reveal one more letter
+            if (framesCounter % 12 == 0) {  // Every 12 ticks, reveal one more letter
                 lettersCount++;
                 framesCounter = 0;  // Reset the frame counter
             }
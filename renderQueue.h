@@ -0,0 +1,192 @@
+#ifndef RENDER_QUEUE_H
+#define RENDER_QUEUE_H
+
+// Include necessary libraries and headers
+#include "raylib.h"        // Raylib library for drawing
+#include "textureAtlas.h"  // Sprites drawn from the atlas
+#include "textCache.h"     // Laid out text
+#include <vector>          // Standard vector container
+#include <string>          // Standard string class for queued text
+#include <functional>      // Standard function wrapper for custom draws
+#include <algorithm>       // Standard algorithms (stable_sort)
+#include <climits>         // Limits used for the sort keys of text and custom draws
+
+using namespace std;  // Use the standard namespace
+
+// Define the layers of the world, drawn in this order
+enum RenderLayer {
+    RENDER_GROUND,     // Background
+    RENDER_WATER,      // Water that is not baked into the static layer
+    RENDER_OBSTACLES,  // Baked water, spawn points, bricks and barriers, or the overview when zoomed out
+    RENDER_TANKS,      // Player and enemy tanks
+    RENDER_SHELLS,     // Flying shells
+    RENDER_CANOPY,     // Trees (tanks drive under them)
+    RENDER_FX,       // Explosions
+    RENDER_HUD,      // Health bar, markers and debug text drawn over the world
+    RENDER_LAYER_COUNT
+};
+
+// Define the draw counts of the last flushed frame
+struct RenderStats {
+    int drawCalls = 0;  // Draw functions the queue called
+    int batches = 0;    // Runs of draws sharing one texture, roughly what the GPU receives
+};
+
+// Define the RenderQueue class
+// Draws are submitted with a layer during the frame and only issued in flush(). Inside a layer they are sorted by texture
+// (stable, so draws on one texture keep their order) and every change of texture starts a new batch.
+class RenderQueue {
+private:
+    // Define the kinds of queued draws
+    enum CommandKind {
+        COMMAND_SPRITE,           // Part of a texture
+        COMMAND_RECTANGLE,        // Filled rectangle
+        COMMAND_RECTANGLE_LINES,  // Rectangle outline
+        COMMAND_CIRCLE,           // Filled circle
+        COMMAND_TEXT,             // Text in the default font
+        COMMAND_CUSTOM            // Callback for draws that need their own state (shaders)
+    };
+
+    // Define a queued draw
+    struct Command {
+        CommandKind kind;         // What to draw
+        unsigned int key;         // Texture the draw uses, the sort key
+        Texture2D texture;        // Texture of a sprite
+        Rectangle source;         // Part of the texture of a sprite
+        Rectangle dest;           // Where to draw (x, y only for circles and text)
+        Vector2 origin;           // Rotation origin of a sprite
+        float rotation;           // Rotation of a sprite in degrees
+        float size;               // Line thickness, circle radius or font size
+        Color tint;               // Colour of the draw
+        int payload;              // Index of the text or callback
+    };
+
+    static const unsigned int shapesKey = 0;             // Shapes share raylib's white texture
+    static const unsigned int textKey = UINT_MAX - 1;    // Text uses the font texture
+    static const unsigned int customKey = UINT_MAX;      // Custom draws are always a batch of their own
+
+    vector<Command> layers[RENDER_LAYER_COUNT];  // Draws waiting in each layer
+    vector<string> texts;                        // Text of the queued text draws
+    vector<function<void()>> customs;            // Callbacks of the queued custom draws
+    RenderStats stats;                           // Counts of the last flush
+    TextCache* textCache = nullptr;              // Turns text into glyph quads that batch like sprites (DrawText is used without it)
+
+    // Queue a draw in a layer
+    void push(RenderLayer layer, const Command& command) {
+        layers[layer].push_back(command);
+    }
+
+    // Issue one queued draw
+    void execute(const Command& command) {
+        switch (command.kind) {
+        case COMMAND_SPRITE:
+            DrawTexturePro(command.texture, command.source, command.dest, command.origin, command.rotation, command.tint);
+            break;
+        case COMMAND_RECTANGLE:
+            DrawRectangleRec(command.dest, command.tint);
+            break;
+        case COMMAND_RECTANGLE_LINES:
+            DrawRectangleLinesEx(command.dest, command.size, command.tint);
+            break;
+        case COMMAND_CIRCLE:
+            DrawCircleV({ command.dest.x, command.dest.y }, command.size, command.tint);
+            break;
+        case COMMAND_TEXT:
+            DrawText(texts[command.payload].c_str(), (int)command.dest.x, (int)command.dest.y, (int)command.size, command.tint);
+            break;
+        case COMMAND_CUSTOM:
+            customs[command.payload]();
+            break;
+        }
+    }
+
+public:
+    RenderQueue() {}  // Default constructor
+
+    // Queue a sprite like drawSprite
+    void sprite(RenderLayer layer, const Sprite& sprite, Rectangle dest, Vector2 origin, float rotation, Color tint) {
+        push(layer, { COMMAND_SPRITE, sprite.texture.id, sprite.texture, sprite.source, dest, origin, rotation, 0.0f, tint, -1 });
+    }
+
+    // Queue a sprite at its own size like drawSpriteAt
+    void spriteAt(RenderLayer layer, const Sprite& sprite, float x, float y, Color tint) {
+        this->sprite(layer, sprite, { x, y, (float)sprite.width, (float)sprite.height }, { 0.0f, 0.0f }, 0.0f, tint);
+    }
+
+    // Queue part of a texture like DrawTexturePro (textures outside the atlas)
+    void texture(RenderLayer layer, const Texture2D& texture, Rectangle source, Rectangle dest, Color tint) {
+        push(layer, { COMMAND_SPRITE, texture.id, texture, source, dest, { 0.0f, 0.0f }, 0.0f, 0.0f, tint, -1 });
+    }
+
+    // Queue a filled rectangle
+    void rectangle(RenderLayer layer, Rectangle rect, Color color) {
+        push(layer, { COMMAND_RECTANGLE, shapesKey, { 0 }, { 0 }, rect, { 0.0f, 0.0f }, 0.0f, 0.0f, color, -1 });
+    }
+
+    // Queue a rectangle outline
+    void rectangleLines(RenderLayer layer, Rectangle rect, float thickness, Color color) {
+        push(layer, { COMMAND_RECTANGLE_LINES, shapesKey, { 0 }, { 0 }, rect, { 0.0f, 0.0f }, 0.0f, thickness, color, -1 });
+    }
+
+    // Queue a filled circle
+    void circle(RenderLayer layer, Vector2 centre, float radius, Color color) {
+        push(layer, { COMMAND_CIRCLE, shapesKey, { 0 }, { 0 }, { centre.x, centre.y, 0.0f, 0.0f }, { 0.0f, 0.0f }, 0.0f, radius, color, -1 });
+    }
+
+    // Lay text out with a cache from now on
+    void useTextCache(TextCache& cache) {
+        textCache = &cache;
+    }
+
+    // Queue text in the default font
+    void text(RenderLayer layer, const string& text, float x, float y, int fontSize, Color color) {
+        if (textCache != nullptr) {  // One sprite per glyph, all from the font texture
+            Texture2D fontTexture = textCache->texture();
+            for (const auto& quad : textCache->get(text, fontSize).quads) {
+                Rectangle dest = { (float)(int)x + quad.dest.x, (float)(int)y + quad.dest.y, quad.dest.width, quad.dest.height };  // DrawText puts text on whole pixels
+                push(layer, { COMMAND_SPRITE, fontTexture.id, fontTexture, quad.source, dest, { 0.0f, 0.0f }, 0.0f, 0.0f, color, -1 });
+            }
+            return;
+        }
+
+        texts.push_back(text);
+        push(layer, { COMMAND_TEXT, textKey, { 0 }, { 0 }, { x, y, 0.0f, 0.0f }, { 0.0f, 0.0f }, 0.0f, (float)fontSize, color, (int)texts.size() - 1 });
+    }
+
+    // Queue a callback that draws by itself (e.g. inside a shader), it is never merged with other draws
+    void custom(RenderLayer layer, const function<void()>& draw) {
+        customs.push_back(draw);
+        push(layer, { COMMAND_CUSTOM, customKey, { 0 }, { 0 }, { 0 }, { 0.0f, 0.0f }, 0.0f, 0.0f, WHITE, (int)customs.size() - 1 });
+    }
+
+    // Issue every queued draw, layer by layer, then empty the queue
+    void flush() {
+        stats = RenderStats();
+
+        unsigned int currentKey = 0;  // Texture of the batch being filled
+        bool first = true;
+        for (auto& layer : layers) {
+            stable_sort(layer.begin(), layer.end(), [](const Command& first, const Command& second) { return first.key < second.key; });
+
+            for (const auto& command : layer) {
+                if (first || command.key != currentKey || command.kind == COMMAND_CUSTOM) stats.batches++;  // Texture changed, raylib starts a new batch
+                currentKey = command.key;
+                first = false;
+
+                execute(command);
+                stats.drawCalls++;
+            }
+            layer.clear();  // Keeps the memory for the next frame
+        }
+
+        texts.clear();
+        customs.clear();
+    }
+
+    // Get the counts of the last flush
+    const RenderStats& getStats() const {
+        return stats;
+    }
+};
+
+#endif
@@ -0,0 +1,102 @@
+#ifndef SIM_RANDOM_H
+#define SIM_RANDOM_H
+
+// Include necessary libraries and headers
+#include <cstdint>  // Fixed width integer types
+#include <random>   // Standard random_device for a fresh seed
+
+using namespace std;  // Use the standard namespace
+
+// Define the RandomStream class
+// A small PCG32 generator: 16 bytes of state, so streams are cheap to make and copy. Ranges are worked out here rather than
+// with the standard distributions, whose results differ between standard libraries, so a seed gives the same numbers everywhere.
+class RandomStream {
+private:
+    uint64_t state = 0;      // Current state
+    uint64_t increment = 1;  // Odd step that picks the sequence, different for every stream
+
+public:
+    RandomStream() {}  // Default constructor
+
+    // Start the stream from a seed, streams with the same seed and a different id give unrelated numbers
+    RandomStream(uint64_t seed, uint64_t streamId) {
+        state = 0;
+        increment = (streamId << 1u) | 1u;
+        next();
+        state += seed;
+        next();
+    }
+
+    // Get the next 32 random bits
+    uint32_t next() {
+        uint64_t old = state;
+        state = old * 6364136223846793005ULL + increment;
+        uint32_t xorShifted = (uint32_t)(((old >> 18u) ^ old) >> 27u);
+        uint32_t rotation = (uint32_t)(old >> 59u);
+        return (xorShifted >> rotation) | (xorShifted << ((32u - rotation) & 31u));
+    }
+
+    // Get a whole number from low to high, both included
+    int range(int low, int high) {
+        uint32_t span = (uint32_t)(high - low) + 1u;
+        if (span == 0u) return (int)next();  // The full 32 bit range
+        uint32_t limit = UINT32_MAX - UINT32_MAX % span;  // Drop the top values that would favour the low numbers
+        uint32_t value;
+        do {
+            value = next();
+        } while (value >= limit);
+        return low + (int)(value % span);
+    }
+
+    // Get a number from 0 up to but not including 1
+    float unit() {
+        return (next() >> 8) * (1.0f / 16777216.0f);  // 24 bits, exact in a float
+    }
+};
+
+// Define the streams of the simulation
+enum RandomStreamId {
+    RANDOM_SPAWN,  // Wave spawn points and enemy starting timers
+    RANDOM_AI,     // Enemy direction changes
+    RANDOM_FX,     // Effects only, so cosmetic randomness never shifts the streams the simulation depends on
+    RANDOM_STREAM_COUNT
+};
+
+// Define the SimRandom class
+// One seed for the session and a stream per use, so the same seed and inputs replay the same game
+class SimRandom {
+private:
+    uint64_t seed = 0;                               // Seed of the session
+    RandomStream streams[RANDOM_STREAM_COUNT];       // One generator per use
+
+public:
+    SimRandom() {
+        reseed(0);
+    }
+
+    // Get a seed from the system, for a session nobody asked to reproduce
+    static uint64_t freshSeed() {
+        random_device device;
+        return ((uint64_t)device() << 32) | device();
+    }
+
+    // Restart every stream from a seed
+    void reseed(uint64_t newSeed) {
+        seed = newSeed;
+        for (int id = 0; id < RANDOM_STREAM_COUNT; id++) {
+            streams[id] = RandomStream(seed, (uint64_t)id);
+        }
+    }
+
+    // Get the seed of the session
+    uint64_t getSeed() const {
+        return seed;
+    }
+
+    // Get one of the streams
+    RandomStream& stream(RandomStreamId id) {
+        return streams[id];
+    }
+};
+
+#endif
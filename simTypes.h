@@ -0,0 +1,95 @@
+#ifndef SIM_TYPES_H
+#define SIM_TYPES_H
+
+// Include necessary libraries and headers
+#include <vector>  // Standard vector container for the events of a tick
+#include <cmath>   // Standard math functions (cosf, sinf)
+
+using namespace std;  // Use the standard namespace
+
+#ifdef SIM_HEADLESS
+// Without raylib the simulation headers only need its plain value types and a few math helpers, defined the same way here
+
+#ifndef PI
+#define PI 3.14159265358979323846f
+#endif
+#ifndef DEG2RAD
+#define DEG2RAD (PI/180.0f)
+#endif
+#ifndef RAD2DEG
+#define RAD2DEG (180.0f/PI)
+#endif
+
+// Define a 2D point or direction
+struct Vector2 {
+    float x;
+    float y;
+};
+
+// Define an axis aligned rectangle
+struct Rectangle {
+    float x;
+    float y;
+    float width;
+    float height;
+};
+
+// Define a 2D camera, only its numbers are used (the enemy tanks measure their shell range through it)
+struct Camera2D {
+    Vector2 offset;
+    Vector2 target;
+    float rotation;
+    float zoom;
+};
+
+// Function to check whether two rectangles overlap, like raylib's
+inline bool CheckCollisionRecs(Rectangle rec1, Rectangle rec2) {
+    return (rec1.x < rec2.x + rec2.width && rec1.x + rec1.width > rec2.x) &&
+           (rec1.y < rec2.y + rec2.height && rec1.y + rec1.height > rec2.y);
+}
+
+// Function to turn a screen position into a world position, like raylib's
+inline Vector2 GetScreenToWorld2D(Vector2 position, Camera2D camera) {
+    float x = (position.x - camera.offset.x) / camera.zoom;
+    float y = (position.y - camera.offset.y) / camera.zoom;
+    float c = cosf(-camera.rotation * DEG2RAD), s = sinf(-camera.rotation * DEG2RAD);  // Undo the camera rotation
+    return { x * c - y * s + camera.target.x, x * s + y * c + camera.target.y };
+}
+
+#else
+#include "raylib.h"  // Raylib library for the value types
+#endif
+
+// Define what the player does during one tick, filled by the front end from the keyboard and mouse (or by a bot or a replay)
+struct SimInput {
+    bool up = false;           // Move keys held
+    bool down = false;
+    bool left = false;
+    bool right = false;
+    bool fire = false;         // Fire pressed since the last tick
+    Vector2 aim = { 0, 0 };    // Point in the world the turret aims at
+
+    // Whether any move key is held
+    bool moving() const {
+        return up || down || left || right;
+    }
+};
+
+// Define the things that happen in a tick that the front end may want to show or play
+enum SimEventType {
+    SIM_EVENT_SHELL_FIRED,      // The player fired a shell
+    SIM_EVENT_TILE_HIT,         // A player shell exploded on a brick or barrier
+    SIM_EVENT_PLAYER_HIT,       // An enemy shell hit the player tank
+    SIM_EVENT_ENEMY_DESTROYED   // A player shell destroyed an enemy tank
+};
+
+// Define an event of a tick
+struct SimEvent {
+    SimEventType type;   // What happened
+    Vector2 position;    // Where it happened
+};
+
+// Events of the ticks since the front end last read them, oldest first
+typedef vector<SimEvent> SimEvents;
+
+#endif
@@ -0,0 +1,163 @@
+#ifndef STATIC_LAYER_CACHE_H
+#define STATIC_LAYER_CACHE_H
+
+// Include necessary libraries and headers
+#include "raylib.h"    // Raylib library for render textures and drawing
+#include "viewport.h"  // Visible part of the world
+#include <vector>      // Standard vector container
+#include <functional>  // Standard function wrapper for the bake callback
+#include <cmath>       // Standard math functions (floor, ceil)
+
+using namespace std;  // Use the standard namespace
+
+// Define the StaticLayerCache class
+// The world is cut into bands the width of the canvas. A band on screen is drawn once into a render texture
+// (baked) and then shown as one quad per frame. A destroyed tile only bakes its own square of the band again.
+// Only a few textures exist, a band that scrolls out of view gives its texture to the next one that needs it.
+class StaticLayerCache {
+private:
+    // Define a baked band
+    struct Chunk {
+        RenderTexture2D texture;  // Baked pixels of the band
+        int band = -1;            // Band of the world held by the texture (-1 if free)
+        bool dirty = true;        // Whether the whole band has to be baked again before it is drawn
+        vector<Rectangle> dirtyTiles;  // Parts of a baked band that changed since, baked again on their own
+        unsigned lastUsed = 0;    // Frame the chunk was last needed in
+    };
+
+    vector<Chunk> chunks;    // Render textures shared by the bands
+    float worldWidth = 0.0f;   // Width of a band (the whole canvas)
+    float worldHeight = 0.0f;  // Height of the canvas
+    float bandHeight = 0.0f;   // Height of a band
+    unsigned frame = 0;        // Current frame, used to find the least recently used chunk
+
+    // Find the chunk holding a band, returns -1 if the band is not baked
+    int findChunk(int band) const {
+        for (int i = 0; i < (int)chunks.size(); i++) {
+            if (chunks[i].band == band) return i;
+        }
+        return -1;
+    }
+
+    // Give a band the chunk that was used least recently, returns -1 if every chunk is needed this frame
+    int claimChunk(int band) {
+        int oldest = -1;
+        for (int i = 0; i < (int)chunks.size(); i++) {
+            if (chunks[i].band == -1) {  // A free chunk is the best choice
+                oldest = i;
+                break;
+            }
+            if (chunks[i].lastUsed == frame) continue;  // On screen this frame
+            if (oldest == -1 || chunks[i].lastUsed < chunks[oldest].lastUsed) oldest = i;
+        }
+        if (oldest == -1) return -1;
+
+        chunks[oldest].band = band;  // Reuse the texture, it has the same size for every band
+        chunks[oldest].dirty = true;
+        chunks[oldest].dirtyTiles.clear();  // The whole band is baked anyway
+        return oldest;
+    }
+
+    // Get the range of bands a rectangle covers
+    void bandRange(const Rectangle& area, int& firstBand, int& lastBand) const {
+        int bandCount = (int)ceil(worldHeight / bandHeight);
+        firstBand = (int)floor(area.y / bandHeight);
+        lastBand = (int)ceil((area.y + area.height) / bandHeight) - 1;
+        if (firstBand < 0) firstBand = 0;
+        if (lastBand > bandCount - 1) lastBand = bandCount - 1;
+    }
+
+    // Bake an area of a chunk's band, clearing and drawing only inside it
+    void bakeArea(Chunk& chunk, const Rectangle& area, const function<void(const Rectangle&)>& bake) {
+        float bandTop = chunk.band * bandHeight;  // World height of the texture's top row
+        Camera2D bandCamera = { 0 };  // Maps the band onto the texture
+        bandCamera.target = { 0.0f, bandTop };
+        bandCamera.zoom = 1.0f;
+
+        BeginTextureMode(chunk.texture);
+        BeginScissorMode((int)floorf(area.x), (int)floorf(area.y - bandTop), (int)ceilf(area.width), (int)ceilf(area.height));  // The clear and the draws stay inside the area
+        ClearBackground(BLANK);  // Transparent where there is nothing, the background shows through
+        BeginMode2D(bandCamera);
+        bake(area);
+        EndMode2D();
+        EndScissorMode();
+        EndTextureMode();
+    }
+
+public:
+    StaticLayerCache() {}  // Default constructor
+
+    // Create the render textures, returns false if the GPU refused them (the caller then draws without the cache)
+    bool initialise(float canvasWidth, float canvasHeight, float heightOfBand, int chunkCount) {
+        worldWidth = canvasWidth;
+        worldHeight = canvasHeight;
+        bandHeight = heightOfBand;
+
+        chunks.assign(chunkCount, Chunk());
+        for (auto& chunk : chunks) {
+            chunk.texture = LoadRenderTexture((int)worldWidth, (int)bandHeight);
+            if (chunk.texture.id == 0) {  // Out of video memory or no framebuffer support
+                chunks.clear();
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Mark an area of the bands as changed (e.g. a destroyed brick), only that area is baked again
+    void invalidate(const Rectangle& area) {
+        if (chunks.empty()) return;  // Nothing baked yet
+
+        int firstBand, lastBand;
+        bandRange(area, firstBand, lastBand);
+        for (auto& chunk : chunks) {
+            if (chunk.band < firstBand || chunk.band > lastBand || chunk.dirty) continue;  // Not baked, or baked whole anyway
+            chunk.dirtyTiles.push_back(area);
+        }
+    }
+
+    // Make sure every band in view is baked, call it before BeginMode2D (baking switches the render target)
+    // bake draws the static layer of the world rectangle it is given. Returns false if the view needs more bands than there are chunks.
+    bool prepare(const Rectangle& view, const function<void(const Rectangle&)>& bake) {
+        frame++;
+        if (chunks.empty()) return false;
+
+        int firstBand, lastBand;
+        bandRange(view, firstBand, lastBand);
+
+        for (int band = firstBand; band <= lastBand; band++) {
+            int index = findChunk(band);
+            if (index == -1) index = claimChunk(band);
+            if (index == -1) return false;  // Zoomed out too far for the cache
+
+            Chunk& chunk = chunks[index];
+            chunk.lastUsed = frame;
+            if (chunk.dirty) {
+                bakeArea(chunk, { 0.0f, band * bandHeight, worldWidth, bandHeight }, bake);  // Part of the world held by the band
+                chunk.dirty = false;
+            }
+            for (const auto& area : chunk.dirtyTiles) {
+                bakeArea(chunk, area, bake);  // Just the changed tiles, the rest of the band keeps its pixels
+            }
+            chunk.dirtyTiles.clear();
+        }
+        return true;
+    }
+
+    // Draw the baked bands in view (inside the world camera)
+    void draw(const Rectangle& view) {
+        int firstBand, lastBand;
+        bandRange(view, firstBand, lastBand);
+
+        for (int band = firstBand; band <= lastBand; band++) {
+            int index = findChunk(band);
+            if (index == -1) continue;
+
+            const Texture2D& texture = chunks[index].texture.texture;
+            Rectangle source = { 0.0f, 0.0f, (float)texture.width, -(float)texture.height };  // Render textures are stored upside down
+            DrawTextureRec(texture, source, { 0.0f, band * bandHeight }, WHITE);
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,97 @@
+#ifndef TEXT_CACHE_H
+#define TEXT_CACHE_H
+
+// Include necessary libraries and headers
+#include "raylib.h"         // Raylib library for the default font
+#include <vector>           // Standard vector container
+#include <string>           // Standard string class
+#include <unordered_map>    // Standard hash map for the cached runs
+
+using namespace std;  // Use the standard namespace
+
+// Define a glyph of a laid out text, relative to the text's top left corner
+struct GlyphQuad {
+    Rectangle source;  // Part of the font texture
+    Rectangle dest;    // Where the glyph goes
+};
+
+// Define a laid out text
+struct GlyphRun {
+    vector<GlyphQuad> quads;  // One quad per visible glyph
+    float width = 0.0f;       // Width like MeasureText
+};
+
+// Define the TextCache class
+// Text is laid out into glyph quads of the default font the first time it is seen and kept by content and size, so
+// only text that changed is laid out again. Every glyph comes from the one font texture, so all text can share one batch.
+class TextCache {
+private:
+    unordered_map<string, GlyphRun> runs;  // Laid out text keyed by size and content
+    size_t maxRuns = 256;                  // Runs kept before the cache starts over (changing numbers keep adding new ones)
+
+    // Lay a text out the way DrawText does
+    GlyphRun layout(const string& text, int fontSize) {
+        GlyphRun run;
+        Font font = GetFontDefault();
+        if (font.texture.id == 0 || font.glyphs == nullptr) return run;  // No font loaded yet
+
+        const int defaultFontSize = 10;  // DrawText never draws smaller than the font's own size
+        if (fontSize < defaultFontSize) fontSize = defaultFontSize;
+        float spacing = (float)(fontSize / defaultFontSize);
+        float scale = (float)fontSize / font.baseSize;
+        float padding = (float)font.glyphPadding;
+
+        float x = 0.0f, y = 0.0f;
+        for (size_t i = 0; i < text.size(); ) {
+            int byteCount = 0;
+            int codepoint = GetCodepointNext(text.c_str() + i, &byteCount);
+            i += byteCount > 0 ? byteCount : 1;
+
+            if (codepoint == '\n') {  // Same line gap as raylib's default
+                y += fontSize + 2;
+                x = 0.0f;
+                continue;
+            }
+
+            int index = GetGlyphIndex(font, codepoint);
+            const Rectangle& rec = font.recs[index];
+            if (codepoint != ' ' && codepoint != '\t') {
+                run.quads.push_back({
+                    { rec.x - padding, rec.y - padding, rec.width + 2.0f * padding, rec.height + 2.0f * padding },
+                    { x + (font.glyphs[index].offsetX - padding) * scale, y + (font.glyphs[index].offsetY - padding) * scale,
+                      (rec.width + 2.0f * padding) * scale, (rec.height + 2.0f * padding) * scale }
+                });
+            }
+
+            float advance = font.glyphs[index].advanceX == 0 ? rec.width : (float)font.glyphs[index].advanceX;
+            x += advance * scale + spacing;
+            if (x - spacing > run.width) run.width = x - spacing;  // No spacing after the last glyph
+        }
+        return run;
+    }
+
+public:
+    TextCache() {}  // Default constructor
+
+    // Get a text laid out at a font size, laid out now if it was not cached
+    const GlyphRun& get(const string& text, int fontSize) {
+        string key = to_string(fontSize) + '|' + text;
+        auto it = runs.find(key);
+        if (it != runs.end()) return it->second;
+
+        if (runs.size() >= maxRuns) runs.clear();
+        return runs.emplace(key, layout(text, fontSize)).first->second;
+    }
+
+    // Get the width of a text like MeasureText, from the cache
+    int measure(const string& text, int fontSize) {
+        return (int)get(text, fontSize).width;
+    }
+
+    // Get the texture every glyph comes from
+    Texture2D texture() const {
+        return GetFontDefault().texture;
+    }
+};
+
+#endif
@@ -0,0 +1,116 @@
+#ifndef TEXTURE_ATLAS_H
+#define TEXTURE_ATLAS_H
+
+// Include necessary libraries and headers
+#include "raylib.h"   // Raylib library for images and textures
+#include <vector>     // Standard vector container
+#include <map>        // Standard map container
+#include <string>     // Standard string class
+#include <algorithm>  // Standard algorithms (sort)
+
+using namespace std;  // Use the standard namespace
+
+// Define a sprite, a sub rectangle of an atlas texture
+// width and height are the sprite's own size, so code that only needs the size reads them like a Texture2D.
+struct Sprite {
+    Texture2D texture = { 0 };     // Atlas texture the sprite lives in
+    Rectangle source = { 0 };      // Part of the atlas holding the sprite
+    int width = 0;                 // Width of the sprite in pixels
+    int height = 0;                // Height of the sprite in pixels
+};
+
+// Function to draw a sprite like DrawTexturePro (destination, origin and rotation)
+void drawSprite(const Sprite& sprite, Rectangle dest, Vector2 origin, float rotation, Color tint) {
+    DrawTexturePro(sprite.texture, sprite.source, dest, origin, rotation, tint);
+}
+
+// Function to draw a sprite at its own size like DrawTexture
+void drawSpriteAt(const Sprite& sprite, float x, float y, Color tint) {
+    DrawTextureRec(sprite.texture, sprite.source, { x, y }, tint);
+}
+
+// Define the TextureAtlas class
+// Images are added by name while the game loads, then build() packs them into one texture on shelves
+// (rows filled left to right, tallest images first) with a transparent gap around each one so filtering
+// never picks up a neighbour. Drawing everything from one texture lets raylib batch the sprites together.
+class TextureAtlas {
+private:
+    // Define an image waiting to be packed
+    struct PendingImage {
+        string name;  // Name used to look the sprite up
+        Image image;  // Pixels of the sprite (owned by the atlas until build)
+    };
+
+    vector<PendingImage> pending;       // Images added since the last build
+    map<string, Rectangle> regions;     // Where each sprite ended up in the atlas
+    Texture2D texture = { 0 };          // The packed atlas
+    int padding = 2;                    // Empty pixels around every sprite
+
+public:
+    TextureAtlas() {}  // Default constructor
+
+    // Add an image to pack, the atlas takes it over and unloads it after packing
+    void add(const string& name, Image image) {
+        pending.push_back({ name, image });
+    }
+
+    // Pack every added image into the atlas texture, returns false if the GPU texture could not be created
+    bool build(int maxWidth = 1024) {
+        // Tallest first keeps the shelves tight
+        vector<int> order(pending.size());
+        for (size_t i = 0; i < pending.size(); i++) order[i] = (int)i;
+        sort(order.begin(), order.end(), [this](int first, int second) { return pending[first].image.height > pending[second].image.height; });
+
+        // Place the images on shelves
+        vector<Rectangle> placed(pending.size());
+        int x = padding, y = padding, shelfHeight = 0, usedWidth = 0;
+        for (int index : order) {
+            const Image& image = pending[index].image;
+            if (x + image.width + padding > maxWidth && x > padding) {  // Shelf full, start the next one under it
+                x = padding;
+                y += shelfHeight + padding;
+                shelfHeight = 0;
+            }
+            placed[index] = { (float)x, (float)y, (float)image.width, (float)image.height };
+            x += image.width + padding;
+            if (x > usedWidth) usedWidth = x;
+            if (image.height > shelfHeight) shelfHeight = image.height;
+        }
+        int usedHeight = y + shelfHeight + padding;
+
+        // Copy the images into one image and upload it
+        Image atlasImage = GenImageColor(usedWidth, usedHeight, BLANK);
+        for (size_t i = 0; i < pending.size(); i++) {
+            const Image& image = pending[i].image;
+            ImageDraw(&atlasImage, image, { 0, 0, (float)image.width, (float)image.height }, placed[i], WHITE);
+            regions[pending[i].name] = placed[i];
+            UnloadImage(image);
+        }
+        pending.clear();
+
+        if (texture.id != 0) UnloadTexture(texture);  // Built again, drop the old atlas
+        texture = LoadTextureFromImage(atlasImage);
+        UnloadImage(atlasImage);
+        return texture.id != 0;
+    }
+
+    // Look a sprite up by name (an empty sprite if the name was never added)
+    Sprite get(const string& name) const {
+        Sprite sprite;
+        auto it = regions.find(name);
+        if (it == regions.end()) return sprite;
+
+        sprite.texture = texture;
+        sprite.source = it->second;
+        sprite.width = (int)it->second.width;
+        sprite.height = (int)it->second.height;
+        return sprite;
+    }
+
+    // Get the atlas texture
+    const Texture2D& getTexture() const {
+        return texture;
+    }
+};
+
+#endif
@@ -0,0 +1,311 @@
+#ifndef TILE_MAP_H
+#define TILE_MAP_H
+
+// Include necessary libraries and headers
+#include "simTypes.h"  // Rectangle type, from raylib unless built headless
+#include <vector>    // Standard vector container
+#include <cmath>     // Standard math functions (floor, ceil)
+#include <cstdint>   // Fixed width integer types
+#include <cassert>   // Standard assert for maps the row masks cannot hold
+#include <iostream>  // Standard error stream for the same
+
+using namespace std;  // Use the standard namespace
+
+// Define an enumeration for the contents of a single 30px tile
+enum TileType : unsigned char {
+    TILE_EMPTY,    // Represents an empty tile
+    TILE_BRICK,    // Represents a brick tile (destructible)
+    TILE_BARRIER,  // Represents a barrier tile (indestructible)
+    TILE_TREE,     // Represents a tree tile (tanks and shells pass under it)
+    TILE_WATER,    // Represents a water tile (stops tanks, not shells)
+    TILE_SPAWN,    // Represents a tile of an enemy spawn point
+    TILE_TYPE_COUNT  // Number of tile types
+};
+
+// Define the collision properties a tile type can have
+enum TileFlag : unsigned char {
+    TILE_BLOCKS_TANKS = 1 << 0,   // Tanks cannot drive into the tile
+    TILE_BLOCKS_SHELLS = 1 << 1,  // Shells explode on the tile
+    TILE_DESTRUCTIBLE = 1 << 2    // A shell hit removes the tile
+};
+
+// Collision properties of each tile type, indexed by TileType
+const unsigned char tileFlags[TILE_TYPE_COUNT] = {
+    0,                                                        // TILE_EMPTY
+    TILE_BLOCKS_TANKS | TILE_BLOCKS_SHELLS | TILE_DESTRUCTIBLE,  // TILE_BRICK
+    TILE_BLOCKS_TANKS | TILE_BLOCKS_SHELLS,                   // TILE_BARRIER
+    0,                                                        // TILE_TREE
+    TILE_BLOCKS_TANKS,                                        // TILE_WATER
+    0                                                         // TILE_SPAWN
+};
+
+// Define the TileMap class
+// The world stored as one byte per 30px tile. Next to the bytes every tile row keeps a bit mask
+// per collision flag (one bit per column), so a rectangle test is one AND per row it covers.
+// During a frame the map only changes at publish(): destroyed tiles are queued and applied there in one go,
+// so every query between two publishes sees the same world and readers on other threads need no lock.
+class TileMap {
+private:
+    vector<unsigned char> tiles;      // Tile types, row by row
+    vector<uint64_t> tankRowMask;     // Columns that block tanks, one mask per tile row
+    vector<uint64_t> shellRowMask;    // Columns that block shells, one mask per tile row
+
+    vector<int> pendingClears;        // Tiles destroyed since the last publish (row * columns + column)
+
+    // Update the row masks of a tile after its type changed
+    void refreshMasks(int column, int row) {
+        uint64_t bit = (uint64_t)1 << column;  // Bit of the tile inside its row mask
+        unsigned char flags = tileFlags[tiles[(size_t)row * columns + column]];  // Properties of the new type
+
+        if (flags & TILE_BLOCKS_TANKS) tankRowMask[row] |= bit; else tankRowMask[row] &= ~bit;  // Update the tank mask
+        if (flags & TILE_BLOCKS_SHELLS) shellRowMask[row] |= bit; else shellRowMask[row] &= ~bit;  // Update the shell mask
+    }
+
+public:
+    static constexpr float tileSize = 30.0f;  // Size of a tile in pixels
+    static constexpr int maxColumns = 64;     // Widest map the row masks can hold
+
+    int columns = 0;  // Number of tiles across the map
+    int rows = 0;     // Number of tiles down the map
+
+    TileMap() {}  // Default constructor
+
+    // Allocate an empty map of the given size in tiles, a map wider than maxColumns is an error
+    void resize(int tileColumns, int tileRows) {
+        if (tileColumns > maxColumns) {  // The row masks hold at most 64 columns, the rest would have no collision
+            cerr << "TILE MAP: " << tileColumns << " columns is wider than the " << maxColumns << " the row masks can hold" << endl;
+            assert(tileColumns <= maxColumns && "map wider than TileMap::maxColumns");
+        }
+        columns = tileColumns > maxColumns ? maxColumns : tileColumns;  // Release builds keep running on the columns that fit
+        rows = tileRows;
+
+        tiles.assign((size_t)columns * rows, TILE_EMPTY);  // Every tile starts empty
+        tankRowMask.assign(rows, 0);  // No tile blocks tanks yet
+        shellRowMask.assign(rows, 0);  // No tile blocks shells yet
+
+        pendingClears.clear();  // A new map has nothing waiting
+    }
+
+    // Check whether tile coordinates are inside the map
+    bool inBounds(int column, int row) const {
+        return column >= 0 && column < columns && row >= 0 && row < rows;
+    }
+
+    // Get the type of a tile (tiles outside the map are empty)
+    TileType at(int column, int row) const {
+        if (!inBounds(column, row)) return TILE_EMPTY;
+        return (TileType)tiles[(size_t)row * columns + column];
+    }
+
+    // Change the type of a tile (building the map only, use queueClear while the game runs)
+    void set(int column, int row, TileType type) {
+        if (!inBounds(column, row)) return;
+        tiles[(size_t)row * columns + column] = type;
+        refreshMasks(column, row);
+    }
+
+    // Queue a tile for removal, queries keep seeing it until the next publish
+    void queueClear(int column, int row) {
+        if (!inBounds(column, row)) return;
+        int index = row * columns + column;
+        for (int pending : pendingClears) {
+            if (pending == index) return;  // Hit twice in the same frame
+        }
+        pendingClears.push_back(index);
+    }
+
+    // Apply the queued removals, the one point per frame where the map changes (no other thread may be reading)
+    // Fills clearedTiles with the world rectangles of the removed tiles and returns how many there were.
+    int publish(vector<Rectangle>& clearedTiles) {
+        clearedTiles.clear();
+        for (int index : pendingClears) {
+            int column = index % columns, row = index / columns;
+            set(column, row, TILE_EMPTY);
+            clearedTiles.push_back(tileRect(column, row));
+        }
+        pendingClears.clear();
+        return (int)clearedTiles.size();
+    }
+
+    // Property lookups by tile coordinate
+    bool isSolid(int column, int row) const { return (tileFlags[at(column, row)] & (TILE_BLOCKS_TANKS | TILE_BLOCKS_SHELLS)) == (TILE_BLOCKS_TANKS | TILE_BLOCKS_SHELLS); }
+    bool blocksShells(int column, int row) const { return (tileFlags[at(column, row)] & TILE_BLOCKS_SHELLS) != 0; }
+    bool blocksTanks(int column, int row) const { return (tileFlags[at(column, row)] & TILE_BLOCKS_TANKS) != 0; }
+    bool isDestructible(int column, int row) const { return (tileFlags[at(column, row)] & TILE_DESTRUCTIBLE) != 0; }
+
+    // Get the mask of columns in a row that have the given flag (TILE_BLOCKS_TANKS or TILE_BLOCKS_SHELLS)
+    uint64_t rowMask(int row, TileFlag flag) const {
+        return flag == TILE_BLOCKS_TANKS ? tankRowMask[row] : shellRowMask[row];
+    }
+
+    // Convert a rectangle into the range of tiles it overlaps, returns false if it is outside the map
+    bool tileRange(const Rectangle& area, int& firstColumn, int& lastColumn, int& firstRow, int& lastRow) const {
+        firstColumn = (int)floor(area.x / tileSize);  // Leftmost tile touched by the rectangle
+        firstRow = (int)floor(area.y / tileSize);  // Topmost tile touched by the rectangle
+        lastColumn = (int)ceil((area.x + area.width) / tileSize) - 1;  // Rightmost tile (a rectangle ending on a tile edge does not enter the next tile)
+        lastRow = (int)ceil((area.y + area.height) / tileSize) - 1;  // Bottommost tile
+
+        if (firstColumn < 0) firstColumn = 0;  // Clamp the range to the map
+        if (firstRow < 0) firstRow = 0;
+        if (lastColumn > columns - 1) lastColumn = columns - 1;
+        if (lastRow > rows - 1) lastRow = rows - 1;
+
+        return firstColumn <= lastColumn && firstRow <= lastRow;  // Empty range if the rectangle lies outside the map
+    }
+
+    // Get the index of the lowest set bit of a non-zero row mask (the leftmost column in it)
+    static int lowestColumn(uint64_t mask) {
+        int column = 0;
+        while (!(mask & 1)) {
+            mask >>= 1;
+            column++;
+        }
+        return column;
+    }
+
+    // Get the mask with the bits of the columns firstColumn..lastColumn set
+    static uint64_t columnSpan(int firstColumn, int lastColumn) {
+        uint64_t upTo = (lastColumn >= 63) ? ~(uint64_t)0 : (((uint64_t)1 << (lastColumn + 1)) - 1);  // Bits 0..lastColumn
+        uint64_t below = ((uint64_t)1 << firstColumn) - 1;  // Bits 0..firstColumn-1
+        return upTo & ~below;
+    }
+
+    // Check whether the rectangle overlaps any tile with the given flag
+    bool overlaps(const Rectangle& area, TileFlag flag) const {
+        int firstColumn, lastColumn, firstRow, lastRow;
+        if (!tileRange(area, firstColumn, lastColumn, firstRow, lastRow)) return false;
+
+        uint64_t span = columnSpan(firstColumn, lastColumn);  // Columns covered by the rectangle
+        for (int row = firstRow; row <= lastRow; row++) {
+            if (rowMask(row, flag) & span) return true;  // One AND tests the whole row
+        }
+        return false;
+    }
+
+    // Find the first tile (top to bottom, left to right) with the given flag that the rectangle overlaps
+    bool firstOverlap(const Rectangle& area, TileFlag flag, int& hitColumn, int& hitRow) const {
+        int firstColumn, lastColumn, firstRow, lastRow;
+        if (!tileRange(area, firstColumn, lastColumn, firstRow, lastRow)) return false;
+
+        uint64_t span = columnSpan(firstColumn, lastColumn);  // Columns covered by the rectangle
+        for (int row = firstRow; row <= lastRow; row++) {
+            uint64_t hits = rowMask(row, flag) & span;  // Flagged tiles under the rectangle in this row
+            if (hits) {
+                hitColumn = lowestColumn(hits);  // Lowest set bit is the leftmost tile
+                hitRow = row;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Sweep a rectangle along a unit direction through the grid (DDA over the tile edges its leading sides cross)
+    // and find the first tile with the given flag it runs into. Returns false if nothing is hit within maxDistance.
+    bool sweep(const Rectangle& area, Vector2 direction, float maxDistance, TileFlag flag, float& hitDistance, int& hitColumn, int& hitRow) const {
+        if (firstOverlap(area, flag, hitColumn, hitRow)) {  // Already touching a tile at the start
+            hitDistance = 0.0f;
+            return true;
+        }
+
+        const double epsilon = 1e-6;  // Small step used to look just past a tile edge
+        const double infinity = 1e30;  // Time used for an axis the rectangle does not move along
+
+        double x0 = area.x, y0 = area.y;  // Top-left corner at the start of the sweep
+        double x1 = (double)area.x + area.width, y1 = (double)area.y + area.height;  // Bottom-right corner at the start of the sweep
+        double dx = direction.x, dy = direction.y;  // Direction of travel
+
+        int stepColumn = dx > 0 ? 1 : -1;  // Column entered by each vertical edge crossing
+        int stepRow = dy > 0 ? 1 : -1;  // Row entered by each horizontal edge crossing
+
+        int nextColumn = 0, nextRow = 0;  // Next column and row the leading sides will enter
+        double nextColumnTime = infinity, nextRowTime = infinity;  // Distance at which they enter them
+        double columnTimeStep = infinity, rowTimeStep = infinity;  // Distance between two edge crossings
+
+        if (dx > 0) {  // The right side leads, it enters a column once it passes the column's left edge
+            nextColumn = (int)ceil(x1 / tileSize);
+            nextColumnTime = (nextColumn * tileSize - x1) / dx;
+            columnTimeStep = tileSize / dx;
+        }
+        else if (dx < 0) {  // The left side leads, it enters a column once it passes the column's right edge
+            nextColumn = (int)floor(x0 / tileSize) - 1;
+            nextColumnTime = (x0 - (nextColumn + 1) * tileSize) / -dx;
+            columnTimeStep = tileSize / -dx;
+        }
+
+        if (dy > 0) {  // The bottom side leads
+            nextRow = (int)ceil(y1 / tileSize);
+            nextRowTime = (nextRow * tileSize - y1) / dy;
+            rowTimeStep = tileSize / dy;
+        }
+        else if (dy < 0) {  // The top side leads
+            nextRow = (int)floor(y0 / tileSize) - 1;
+            nextRowTime = (y0 - (nextRow + 1) * tileSize) / -dy;
+            rowTimeStep = tileSize / -dy;
+        }
+
+        while (true) {
+            bool columnEvent = nextColumnTime <= nextRowTime;  // Which edge is crossed first
+            double time = columnEvent ? nextColumnTime : nextRowTime;  // Distance travelled at the crossing
+
+            if (time > maxDistance) return false;  // The path ends before the next tile
+
+            double probe = time + epsilon;  // Look just after the crossing (in double, a float would round the step away)
+            double left = x0 + dx * probe, top = y0 + dy * probe;  // Top-left corner of the rectangle at that point
+
+            int firstColumn = (int)floor(left / tileSize);  // Tiles covered by the rectangle at that point
+            int lastColumn = (int)ceil((left + area.width) / tileSize) - 1;
+            int firstRow = (int)floor(top / tileSize);
+            int lastRow = (int)ceil((top + area.height) / tileSize) - 1;
+
+            if (firstColumn < 0) firstColumn = 0;  // Clamp the range to the map
+            if (firstRow < 0) firstRow = 0;
+            if (lastColumn > columns - 1) lastColumn = columns - 1;
+            if (lastRow > rows - 1) lastRow = rows - 1;
+            if (firstColumn > lastColumn || firstRow > lastRow) return false;  // Left the map
+
+            if (columnEvent) {
+                if (nextColumn < 0 || nextColumn >= columns) {  // No more columns to enter on this side
+                    nextColumnTime = infinity;
+                }
+                else {
+                    uint64_t bit = (uint64_t)1 << nextColumn;
+                    for (int row = firstRow; row <= lastRow; row++) {  // Tiles of the entered column under the rectangle
+                        if (rowMask(row, flag) & bit) {
+                            hitDistance = (float)time;
+                            hitColumn = nextColumn;
+                            hitRow = row;
+                            return true;
+                        }
+                    }
+                    nextColumn += stepColumn;  // Move on to the next column edge
+                    nextColumnTime += columnTimeStep;
+                }
+            }
+            else {
+                if (nextRow < 0 || nextRow >= rows) {  // No more rows to enter on this side
+                    nextRowTime = infinity;
+                }
+                else {
+                    uint64_t hits = rowMask(nextRow, flag) & columnSpan(firstColumn, lastColumn);  // Tiles of the entered row under the rectangle
+                    if (hits) {
+                        hitColumn = lowestColumn(hits);  // Lowest set bit is the leftmost tile
+                        hitDistance = (float)time;
+                        hitRow = nextRow;
+                        return true;
+                    }
+                    nextRow += stepRow;  // Move on to the next row edge
+                    nextRowTime += rowTimeStep;
+                }
+            }
+
+            if (nextColumnTime >= infinity && nextRowTime >= infinity) return false;  // Nothing left to cross
+        }
+    }
+
+    // Get the world rectangle covered by a tile
+    Rectangle tileRect(int column, int row) const {
+        return { column * tileSize, row * tileSize, tileSize, tileSize };
+    }
+};
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef VIEWPORT_H
+#define VIEWPORT_H
+
+// Include necessary libraries and headers
+#include "simTypes.h"  // Camera and screen/world conversion, from raylib unless built headless
+#include <cmath>     // Standard math functions (fminf, fmaxf)
+
+// Function to get the part of the world the camera shows, the bounds of the four screen corners in world space
+Rectangle visibleWorldRect(const Camera2D& camera, int screenWidth, int screenHeight) {
+    Vector2 corners[4] = {
+        GetScreenToWorld2D({ 0, 0 }, camera),
+        GetScreenToWorld2D({ (float)screenWidth, 0 }, camera),
+        GetScreenToWorld2D({ 0, (float)screenHeight }, camera),
+        GetScreenToWorld2D({ (float)screenWidth, (float)screenHeight }, camera)
+    };
+
+    float left = corners[0].x, right = corners[0].x, top = corners[0].y, bottom = corners[0].y;
+    for (int i = 1; i < 4; i++) {  // A rotated camera shows a tilted rectangle, take its bounds
+        left = fminf(left, corners[i].x);
+        right = fmaxf(right, corners[i].x);
+        top = fminf(top, corners[i].y);
+        bottom = fmaxf(bottom, corners[i].y);
+    }
+
+    return { left, top, right - left, bottom - top };
+}
+
+// Function to check whether something drawn inside the given bounds can be seen
+bool isVisible(const Rectangle& bounds, const Rectangle& view) {
+    return CheckCollisionRecs(bounds, view);
+}
+
+// Function to get the smallest rectangle that holds two rectangles
+Rectangle unionRect(const Rectangle& first, const Rectangle& second) {
+    float left = fminf(first.x, second.x), top = fminf(first.y, second.y);
+    float right = fmaxf(first.x + first.width, second.x + second.width);
+    float bottom = fmaxf(first.y + first.height, second.y + second.height);
+    return { left, top, right - left, bottom - top };
+}
+
+#endif
@@ -0,0 +1,115 @@
+#ifndef WATER_SHADER_H
+#define WATER_SHADER_H
+
+// Include necessary libraries and headers
+#include "raylib.h"        // Raylib library for shaders and textures
+#include "textureAtlas.h"  // The water strip is a sprite of the atlas
+
+// Fragment shader that turns water key pixels into the current frame of the water strip
+// A key pixel has alpha 0 and blue 1, red and green hold its position inside the tile. Every other pixel is drawn unchanged,
+// so the shader can be used for anything that is drawn right after the baked bands.
+const char* waterFragmentShader = R"(
+#version 330
+in vec2 fragTexCoord;
+in vec4 fragColor;
+uniform sampler2D texture0;
+uniform vec4 colDiffuse;
+uniform sampler2D waterStrip;
+uniform vec4 stripRect;
+uniform float frameCount;
+uniform float frameTime;
+uniform float time;
+out vec4 finalColor;
+
+void main()
+{
+    vec4 texel = texture(texture0, fragTexCoord);
+    if (texel.a == 0.0 && texel.b > 0.5) {
+        float frame = mod(floor(time / frameTime), frameCount);
+        vec2 uv = stripRect.xy + vec2((frame + texel.r) * stripRect.z, texel.g * stripRect.w);
+        finalColor = texture(waterStrip, uv) * fragColor;
+    } else {
+        finalColor = texel * colDiffuse * fragColor;
+    }
+}
+)";
+
+// Define the WaterShader class
+// Water tiles are baked into the static bands as key pixels, the shader picks the animation frame from a time uniform
+// while the bands are drawn. The water then costs no draw calls of its own and the bands never have to be baked again for it.
+class WaterShader {
+private:
+    Shader shader = { 0 };         // The compiled shader
+    Texture2D keyTexture = { 0 };  // One tile of key pixels, repeated wherever there is water
+    bool ready = false;            // Whether the shader compiled (the game draws the water itself otherwise)
+    int stripLoc = -1;             // Uniform locations
+    int stripRectLoc = -1;
+    int frameCountLoc = -1;
+    int frameTimeLoc = -1;
+    int timeLoc = -1;
+
+public:
+    WaterShader() {}  // Default constructor
+
+    // Compile the shader and create the key tile, returns false if the shader could not be used
+    bool load(int tileSize) {
+        shader = LoadShaderFromMemory(0, waterFragmentShader);  // Default vertex shader
+        stripLoc = GetShaderLocation(shader, "waterStrip");
+        stripRectLoc = GetShaderLocation(shader, "stripRect");
+        frameCountLoc = GetShaderLocation(shader, "frameCount");
+        frameTimeLoc = GetShaderLocation(shader, "frameTime");
+        timeLoc = GetShaderLocation(shader, "time");
+        ready = stripLoc != -1 && timeLoc != -1;  // raylib falls back to its default shader when compiling fails, it has none of these uniforms
+
+        Image key = GenImageColor(tileSize, tileSize, BLANK);
+        for (int y = 0; y < tileSize; y++) {
+            for (int x = 0; x < tileSize; x++) {
+                unsigned char u = (unsigned char)((x + 0.5f) * 255.0f / tileSize);  // Centre of the pixel inside the tile
+                unsigned char v = (unsigned char)((y + 0.5f) * 255.0f / tileSize);
+                ImageDrawPixel(&key, x, y, { u, v, 255, 0 });  // Written as is, no blending
+            }
+        }
+        keyTexture = LoadTextureFromImage(key);
+        UnloadImage(key);
+        SetTextureWrap(keyTexture, TEXTURE_WRAP_REPEAT);  // One quad covers a whole merged rectangle of water
+
+        return ready && keyTexture.id != 0;
+    }
+
+    // Whether water can be baked as key pixels
+    bool isReady() const {
+        return ready && keyTexture.id != 0;
+    }
+
+    // Get the key tile, it repeats across the water it is drawn over
+    const Texture2D& keyTile() const {
+        return keyTexture;
+    }
+
+    // Set the strip the frames are taken from, frameCount frames of equal width side by side
+    void setStrip(const Sprite& strip, int frameCount) {
+        const Texture2D& atlas = strip.texture;
+        float rect[4] = {  // Position of the strip and size of one frame, in texture coordinates
+            strip.source.x / atlas.width, strip.source.y / atlas.height,
+            strip.source.width / frameCount / atlas.width, strip.source.height / atlas.height
+        };
+        float count = (float)frameCount;
+        SetShaderValue(shader, stripRectLoc, rect, SHADER_UNIFORM_VEC4);
+        SetShaderValue(shader, frameCountLoc, &count, SHADER_UNIFORM_FLOAT);
+    }
+
+    // Start drawing with the shader, time picks the frame (wrapped by the caller so it keeps its precision)
+    void begin(const Texture2D& atlas, float time, float frameTime) {
+        BeginShaderMode(shader);
+        SetShaderValue(shader, timeLoc, &time, SHADER_UNIFORM_FLOAT);
+        SetShaderValue(shader, frameTimeLoc, &frameTime, SHADER_UNIFORM_FLOAT);
+        SetShaderValueTexture(shader, stripLoc, atlas);  // Bound after BeginShaderMode, for the draws that follow
+    }
+
+    // Stop drawing with the shader
+    void end() {
+        EndShaderMode();
+    }
+};
+
+#endif
@@ -6,6 +6,7 @@
 #include "gameStatus.h"             // Include the header for game status management
 #include "menu.h"                   // Include the header for the game menu
 #include "game.h"                   // Include the header for the main game logic
+#include "fixedTimestep.h"          // Include the header for the fixed simulation ticks
 
 using namespace std;  // Use the standard namespace
 
@@ -18,6 +19,10 @@ private:
     int canvasHeight = 54600;  // Height of the game canvas
     Camera2D camera;  // 2D camera for the game
     float deltaTime;  // Variable to store the time between frames
+    FixedTimestep gameTicks;  // Splits the frame time into fixed ticks for the game simulation
+    float tickTime = gameTicks.getTickTime();  // Time the game advances in one tick
+    bool fastReplay = false;  // Whether a replay runs as fast as possible instead of in real time
+    int fastReplayTicks = 64;  // Ticks run per drawn frame in a fast replay
     Menu menu;  // Instance of the Menu class
 
     GameStatus gameStatus;  // Instance of the GameStatus class
@@ -31,6 +36,7 @@ private:
     Vector2 mousePosition;  // Variable to store the mouse position
 
     const char* gameOverText = "Game Over!";  // Text to display when the game is over
+    int gameOverTextWidth = 0;  // Width of the "Game Over" text, measured once
 
 public:
     int initWindowWidth = 500, initWindowHeight = 500;  // Initial window dimensions
@@ -52,6 +58,7 @@ public:
         SetWindowState(FLAG_WINDOW_UNDECORATED);  // Set the window to be undecorated (no title bar, etc.)
         DisableCursor();  // Disable the default cursor
         crosshair = LoadTexture("img/playerTank/crosshair.png");  // Load the crosshair texture
+        gameOverTextWidth = MeasureText(gameOverText, 150);  // The text never changes, measure it once
 
         screenWidth = GetMonitorWidth(0), screenHeight = GetMonitorHeight(0);  // Get the screen dimensions of the primary monitor
 
@@ -80,15 +87,13 @@ public:
             switch (gameStatus.currentGameState) {  // Switch based on the current game state
             case RaylibAnimation:  // If the current state is the Raylib animation
                 if (!RaylibLogoAnimation.animationCompleted) {  // If the animation is not completed
-                    RaylibLogoAnimation.Update();  // Update the animation
+                    RaylibLogoAnimation.Update(deltaTime);  // Update the animation
                     RaylibLogoAnimation.Draw();  // Draw the animation
                 }
                 else {  // If the animation is completed
                     gameStatus.currentGameState = MainMenu;  // Change the game state to the main menu
 
-                    SetWindowSize(screenWidth, screenHeight);  // Set the window size to the screen dimensions
-
-                    SetWindowState(FLAG_FULLSCREEN_MODE);  // Set the window to fullscreen mode
+                    goFullscreen();  // Set the window to fullscreen mode
                 }
                 break;
             case MainMenu:  // If the current state is the main menu
@@ -105,9 +110,29 @@ public:
 
             case InGame:  // If the current state is in-game
 
-                game.checkCollisions();  // Check for collisions in the game
+                game.updateFrame(deltaTime);  // Quality, music, zoom and input, once per frame
+
+                if (fastReplay && game.isReplaying()) {  // Run a batch of recorded ticks per frame, as fast as the simulation goes
+                    for (int i = 0; i < fastReplayTicks && gameStatus.currentGameState == InGame && game.isReplaying(); i++) {
+                        tick();
+                    }
+                    gameTicks.reset();
+                    game.playEvents();  // Sounds of what happened in the ticks
+                    game.setInterpolation(1.0f);  // Draw the last tick as it is
+                }
+                else {
+                    gameTicks.advance(deltaTime);  // Hand the frame time out in fixed ticks
+                    while (gameStatus.currentGameState == InGame && gameTicks.step()) {  // Zero, one or a few ticks depending on the frame rate
+                        tick();
+                    }
+                    game.playEvents();  // Sounds of what happened in the ticks
+                    game.setInterpolation(gameTicks.alpha());  // Draw between the last two ticks
+                }
+                if (fastReplay && !game.isReplaying()) {  // The recording ran out, back to real time
+                    fastReplay = false;
+                    SetTargetFPS(60);
+                }
 
-                game.update(deltaTime, gameStatus, screenWidth, screenHeight, canvasWidth, canvasHeight);  // Update the game
                 game.startDrawing();  // Start drawing the game
 
                 game.beginCamera2D();  // Begin the 2D camera
@@ -136,7 +161,7 @@ public:
                 ClearBackground(RAYWHITE);  // Clear the background to white
                 menu.drawBG(screenWidth, screenHeight);  // Draw the menu background
 
-                DrawText(gameOverText, (screenWidth - MeasureText(gameOverText, 150)) / 2, (screenHeight - MeasureText(gameOverText, 150)) / 2, 150, MAROON);  // Draw the "Game Over" text
+                DrawText(gameOverText, (screenWidth - gameOverTextWidth) / 2, (screenHeight - gameOverTextWidth) / 2, 150, MAROON);  // Draw the "Game Over" text
                 drawMouseCorsshair();  // Draw the mouse crosshair
                 EndDrawing();  // End drawing
                 break;
@@ -147,6 +172,33 @@ public:
         }
     }
 
+    void tick() {  // Function to advance the game by one fixed tick
+        game.update(tickTime, gameStatus);  // Collision phase, then the moves of the tick
+    }
+
+    void goFullscreen() {  // Function to size the window to the screen and make it fullscreen
+        SetWindowSize(screenWidth, screenHeight);  // Set the window size to the screen dimensions
+
+        SetWindowState(FLAG_FULLSCREEN_MODE);  // Set the window to fullscreen mode
+    }
+
+    bool record(const string& path) {  // Function to record the input of the game to a file
+        return game.startRecording(path, tickTime);
+    }
+
+    bool replay(const string& path, bool asFastAsPossible) {  // Function to play a recorded game back, straight into the game
+        if (!game.startReplay(path, tickTime)) return false;
+
+        goFullscreen();  // Skip the logo and the menu
+        gameStatus.currentGameState = InGame;
+
+        fastReplay = asFastAsPossible;
+        if (fastReplay) {
+            SetTargetFPS(0);  // Do not wait between frames
+        }
+        return true;
+    }
+
     void drawMouseCorsshair() {  // Function to draw the mouse crosshair
         DrawTexture(crosshair, GetMousePosition().x - crosshair.width / 2, GetMousePosition().y - crosshair.height / 2, WHITE);  // Draw the crosshair texture at the mouse position
     }